@@ -0,0 +1,133 @@
+#pragma once
+#include <vector>
+
+#include "Boids.h"
+#include "EntityStore.h"
+
+// Stanje jedne ribe. Koordinate su u NDC prostoru akvarijuma ([-1, 1]), ugao u radijanima.
+struct FishState {
+    float x;
+    float y;
+    float heading;
+    float speed; // NDC jedinica u sekundi
+    float phase; // Faza mahanja repom (animacija), u radijanima
+    float size;
+    float color[3];
+};
+
+// Hrana koju je posjetilac ubacio; polako tone dok je riba ne pojede ili ne istekne
+static const int AQUARIUM_MAX_FOOD = 64;
+struct FoodState {
+    float x;
+    float y;
+    int ticksLeft;
+};
+
+// Dogadjaj sa ulaza koji mijenja simulaciju. Primjenjuje se na pocetku koraka, pa isti niz dogadjaja po koracima
+// uvijek daje isti rezultat.
+struct AquariumInput {
+    enum Type { Feed, Cursor, Key };
+    Type type = Feed;
+    float x = 0; // Feed, Cursor: NDC koordinate akvarijuma
+    float y = 0;
+    int key = 0; // Key: GLFW kod tastera
+    int action = 0; // Key: GLFW_PRESS ili GLFW_RELEASE
+};
+
+// Kursor van prozora: daleko od svih riba
+static const float AQUARIUM_CURSOR_AWAY = 1.0e6f;
+// Razmak (GLFW_KEY_SPACE) rasplasi ribe na sve strane
+static const int AQUARIUM_KEY_SCATTER = 32;
+
+class InputRecorder;
+
+// Granice u kojima ribe plivaju (ispod povrsine vode)
+struct TankBounds {
+    float left = -0.95f;
+    float right = 0.95f;
+    float bottom = -0.95f;
+    float top = 0.55f;
+};
+
+// Komponente entiteta akvarijuma. Riba ima poziciju, kretanje, animaciju i izgled; hrana poziciju i trajanje.
+struct Position {
+    float x;
+    float y;
+};
+
+struct Motion {
+    float heading;
+    float speed;
+};
+
+struct Animation {
+    float phase;
+};
+
+struct Appearance {
+    float size;
+    float color[3];
+};
+
+struct Food {
+    int ticksLeft;
+    unsigned long long sequence; // Redni broj ubacivanja, najstarija nestaje kad je hrane previse
+};
+
+// Simulacija akvarijuma. Napreduje samo fiksnim korakom (step), pa je za isto seme i isti broj koraka
+// rezultat uvijek isti, bez obzira na broj frejmova u sekundi. Cuva i stanje prije poslednjeg koraka,
+// da bi crtanje moglo da interpolira izmedju dva koraka.
+// Ribe i hrana su entiteti u EntityStore, a sistemi u step prolaze kroz nizove komponenti koje im trebaju.
+// Ribe plivaju u jatu (Boids), osim kad bjeze od kursora ili idu ka hrani.
+// Ribe se prave prve i nikad se ne brisu, pa su njihove komponente poravnate na pocetku svakog niza, a
+// getFish ih daje uvijek istim redom (interpolacija uparuje ribe po indeksu).
+class Aquarium {
+public:
+    Aquarium();
+    //Nizovi komponenti su registrovani u entities po adresi
+    Aquarium(const Aquarium&) = delete;
+    Aquarium& operator=(const Aquarium&) = delete;
+
+    void init(int fishCount, unsigned seed, const TankBounds& bounds = TankBounds());
+    void step(float dt);
+    void apply(const AquariumInput& input);
+    // Svaki primijenjeni dogadjaj se upisuje u recorder, sa korakom u kom je primijenjen (nullptr = bez snimanja)
+    void setRecorder(InputRecorder* inputRecorder) { recorder = inputRecorder; }
+
+    const std::vector<FishState>& getFish() const { return current; }
+    const std::vector<FishState>& getPreviousFish() const { return previous; }
+    const std::vector<FoodState>& getFood() const { return food; }
+    unsigned long long getTick() const { return tick; }
+    unsigned getSeed() const { return seed; }
+
+private:
+    float random(); // [0, 1)
+    void exportState();
+
+    EntityStore entities;
+    ComponentPool<Position> positions;
+    ComponentPool<Motion> motions;
+    ComponentPool<Animation> animations;
+    ComponentPool<Appearance> appearances;
+    ComponentPool<Food> foods;
+    std::vector<Entity> expired;
+    Boids boids; // Skalarna verzija: SIMD verzije se razlikuju u zaokruzivanju, a skretanje se sabira kroz korake
+    BoidsFish school; // Ribe u redu gustog niza kretanja, ulaz za boids
+    BoidsParameters schooling;
+
+    std::vector<FishState> current;
+    std::vector<FishState> previous;
+    std::vector<FoodState> food;
+    float cursorX = AQUARIUM_CURSOR_AWAY;
+    float cursorY = AQUARIUM_CURSOR_AWAY;
+    InputRecorder* recorder = nullptr;
+    TankBounds bounds;
+    unsigned seed = 1;
+    unsigned randomState = 1;
+    unsigned long long tick = 0;
+    unsigned long long foodSequence = 0;
+};
+
+// Stanje izmedju dva koraka simulacije: alpha 0 je previous, 1 je current
+void interpolateFish(const std::vector<FishState>& previous, const std::vector<FishState>& current, float alpha,
+    std::vector<FishState>& out);
@@ -0,0 +1,75 @@
+#pragma once
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "FishRenderer.h"
+#include "FrameUniforms.h"
+#include "GLStateCache.h"
+#include "ShaderRegistry.h"
+#include "SimulationThread.h"
+
+struct AquariumWindowStats {
+    unsigned long long frames = 0;
+    double averageMs = 0; // Od swap-a do swap-a
+    double maxMs = 0;
+};
+
+// Dodatni akvarijum u svom prozoru (npr. na drugom monitoru): Kostur --windows 3
+// Kontekst prozora dijeli objekte sa kontekstom glavnog prozora (share u glfwCreateWindow), pa se teksture i sejder
+// programi prave i ucitavaju samo jednom. VAO i framebuffer-i se ne dijele izmedju konteksta, pa svaki prozor ima
+// svoj FishRenderer, uniform bafer i kes stanja. Svaki prozor ima svoju simulaciju i svoju nit crtanja sa svojim
+// swap-om (vsync svog monitora), pa spor prozor ne zaustavlja ostale.
+// create, start, stop i submitInput se pozivaju iz glavne niti, jer GLFW dogadjaje obradjuje samo ona.
+class AquariumWindow {
+public:
+    AquariumWindow() = default;
+    ~AquariumWindow();
+    AquariumWindow(const AquariumWindow&) = delete;
+    AquariumWindow& operator=(const AquariumWindow&) = delete;
+
+    // Pravi prozor i GL objekte u njegovom kontekstu; na kraju je ponovo aktivan kontekst koji je bio aktivan prije.
+    // index odredjuje monitor (ako ih ima dovoljno) i naslov.
+    bool create(GLFWwindow* primary, ShaderRegistry& shaders, int index, int fishCount, unsigned seed, double tickRate,
+        const FrameUniformData& frameData);
+    // Prije start; tekstura je iz glavnog konteksta, pa je prozor samo koristi
+    void setFishTexture(unsigned texture) { fishRenderer.setTexture(texture); }
+    // Pokrece nit crtanja, koja od tada drzi kontekst prozora
+    void start();
+    // Zaustavlja nit (ona brise GL objekte prozora) i simulaciju, pa unistava prozor
+    void stop();
+
+    bool isRunning() const { return thread.joinable(); }
+    bool shouldClose() const { return window != nullptr && glfwWindowShouldClose(window); }
+    GLFWwindow* getWindow() const { return window; }
+    void submitInput(const AquariumInput& input) { simulation.pushInput(input); }
+
+    // Poslije stop
+    AquariumWindowStats getStats() const;
+    void printReport() const;
+
+private:
+    static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+    void renderLoop();
+
+    GLFWwindow* window = nullptr;
+    int index = 0;
+    GLStateCache state;
+    FishRenderer fishRenderer;
+    FrameUniforms frameUniforms;
+    FrameUniformData frameData = {};
+    SimulationThread simulation;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::atomic<int> framebufferWidth{ 0 };
+    std::atomic<int> framebufferHeight{ 0 };
+
+    unsigned long long frames = 0;
+    double totalFrameSeconds = 0;
+    double maxFrameSeconds = 0;
+};
+
+// --windows N: ukupan broj akvarijuma, ukljucujuci glavni prozor (podrazumijevano 1)
+int parseWindowCount(int argc, char** argv);
@@ -0,0 +1,28 @@
+#pragma once
+#include "TextureData.h"
+
+// Blok kompresija (BC1/BC3/BC7) na procesoru. Slika se dijeli na blokove 4x4 piksela koji se kodiraju nezavisno,
+// pa se redovi blokova rasporedjuju na radne niti sistema poslova (JobSystem.h).
+
+class JobSystem;
+
+// Da li drajver podrzava format (GL_EXT_texture_compression_s3tc za BC1/BC3, GL_ARB_texture_compression_bptc za BC7)
+bool isTextureCompressionSupported(TextureCompression format);
+// Bira konkretan format za sliku; vraca None ako trazeni format nije podrzan
+TextureCompression resolveTextureCompression(TextureCompression requested, bool hasAlpha);
+GLenum textureCompressionFormat(TextureCompression format);
+size_t blockCompressedSize(TextureCompression format, int width, int height);
+
+// Kompresuje RGBA8 sliku u blokove (jobs nullptr = zajednicki jobSystem())
+void compressImageBlocks(TextureCompression format, const unsigned char* rgba, int width, int height, unsigned char* blocks, JobSystem* jobs = nullptr);
+// Vraca blokove nazad u RGBA8, koristi se za mjerenje kvaliteta
+void decompressImageBlocks(TextureCompression format, const unsigned char* blocks, int width, int height, unsigned char* rgba);
+
+// Kompresuje sve nivoe dekodovane slike; vraca false (i ne mijenja sliku) ako format nije podrzan
+bool compressTextureImage(TextureImage& image, TextureCompression requested);
+// Isto, ali bez provjere drajvera (za pripremu tekstura unaprijed); format mora biti BC1, BC3 ili BC7
+bool encodeTextureImage(TextureImage& image, TextureCompression format);
+bool textureImageHasAlpha(const TextureImage& image);
+
+// Ispisuje kvalitet (PSNR) i brzinu svakog formata za datu sliku, ukljucujuci dekodovanje na grafickoj kartici
+void printBlockCompressionReport(const char* filePath);
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Jato (boids, Reynolds 1987): riba se odmice od prebliskih susjeda, pliva u pravcu susjeda i prema njihovom sredistu
+struct BoidsParameters {
+    float neighborRadius = 0.15f; // Susjedi su ribe blize od ovoga (i velicina celije mreze)
+    float separationRadius = 0.05f;
+    float separationWeight = 1.5f;
+    float alignmentWeight = 1.0f;
+    float cohesionWeight = 0.8f;
+};
+
+// Ribe u obliku struktura nizova: pozicija i jedinicni vektor pravca
+struct BoidsFish {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> dirX;
+    std::vector<float> dirY;
+
+    void resize(size_t count);
+    size_t size() const { return x.size(); }
+};
+
+// Uniformna mreza celija velicine cellSize preko pravougaonika [minX, maxX] x [minY, maxY]. Pravi se iznova svaki
+// korak sortiranjem prebrojavanjem: broj riba po celiji, prefiksna suma (pocetak celije), pa raspored po celijama.
+// Celije su poredane po redovima, pa su tri susjedne celije u redu jedan neprekinut opseg poredanih riba.
+class SpatialGrid {
+public:
+    void build(const float* x, const float* y, int count, float minX, float minY, float maxX, float maxY, float cellSize);
+
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+    int getCellX(float x) const;
+    int getCellY(float y) const;
+    // Poredane ribe u celijama [cellBegin, cellEnd) istog reda
+    int getRangeBegin(int row, int firstColumn) const { return cellStarts[row * columns + firstColumn]; }
+    int getRangeEnd(int row, int lastColumn) const { return cellStarts[row * columns + lastColumn + 1]; }
+    // Opsezi poredanih riba u 3x3 celija oko tacke, po jedan za svaki red; vraca broj opsega (1..3)
+    int getNeighborRanges(float x, float y, int ranges[3][2]) const;
+    // Poredana pozicija -> indeks ribe u ulazu
+    const std::vector<int>& getOrder() const { return order; }
+
+private:
+    float minX = 0;
+    float minY = 0;
+    float inverseCellSize = 1;
+    int columns = 1;
+    int rows = 1;
+    std::vector<int> cellStarts; // columns * rows + 1
+    std::vector<int> cellOfFish;
+    std::vector<int> order;
+};
+
+// Unutrasnja petlja po susjedima: skalarno, SSE2 (4 susjeda odjednom) ili AVX2 (8 susjeda odjednom). SIMD verzije
+// sabiraju samo susjede koji prodju test udaljenosti (maska) i racunaju 1/d priblizno (rsqrt + jedan Newtonov korak),
+// pa se od skalarne razlikuju u zaokruzivanju: rezultat nije bit-identican izmedju procesora sa i bez AVX2, pa
+// simulacija koristi skalarnu, a najbolju verziju (getBestBoidsKernel) samo benchmark.
+enum class BoidsKernel { Scalar, Sse2, Avx2 };
+
+const char* boidsKernelName(BoidsKernel kernel);
+// SSE2 zavisi od prevodjenja, AVX2 i od procesora (provjerava se jednom, pri prvom pozivu)
+bool isBoidsKernelSupported(BoidsKernel kernel);
+BoidsKernel getBestBoidsKernel();
+
+// Usmjeravanje jata preko mreze: za svaku ribu se gledaju samo ribe iz njene i osam susjednih celija, pa posao raste
+// linearno sa brojem riba (pri istoj gustini). Ribe se prije racunanja prepisuju redom celija u poredane nizove,
+// da susjedi budu jedni do drugih u memoriji.
+class Boids {
+public:
+    // Racuna vektor usmjeravanja za svaku ribu (0, 0 = nema susjeda); vazan je pravac, a duzina raste sa
+    // brojem i blizinom susjeda. Ribe van pravougaonika se racunaju u rubne celije.
+    void update(const BoidsFish& fish, float minX, float minY, float maxX, float maxY, const BoidsParameters& parameters);
+
+    // Podrazumijevano skalarna, jer je jedino ona ista na svakom procesoru (simulacija, snimanje i reprodukcija).
+    // Nepodrzana verzija se zamjenjuje skalarnom.
+    void setKernel(BoidsKernel newKernel);
+    BoidsKernel getKernel() const { return kernel; }
+
+    // Po redu ulaza
+    const std::vector<float>& getSteerX() const { return steerX; }
+    const std::vector<float>& getSteerY() const { return steerY; }
+
+private:
+    SpatialGrid grid;
+    BoidsKernel kernel = BoidsKernel::Scalar;
+    BoidsFish sorted; // Sa dopunom iza poslednje ribe, da SIMD ucitavanje ne izadje iz niza
+    std::vector<float> sortedSteerX;
+    std::vector<float> sortedSteerY;
+    std::vector<float> steerX;
+    std::vector<float> steerY;
+};
+
+// Isto usmjeravanje poredjenjem svake ribe sa svakom, O(n^2); za poredjenje u benchmark-u
+void computeBoidsNaive(const BoidsFish& fish, const BoidsParameters& parameters, std::vector<float>& steerX,
+    std::vector<float>& steerY);
+
+// Poredi verziju sa skalarnom na nasumicnom jatu sa tezim slucajevima (ribe na istom mjestu, van mreze, broj riba
+// koji nije djeljiv sa 8): razlika mora biti manja od tolerance * (1 + |skalarni vektor|)
+bool checkBoidsKernel(BoidsKernel kernel, float tolerance = 1e-4f);
+// Provjerava sve SIMD verzije koje procesor podrzava; Kostur --boids-check vraca 1 ako neka nije u granici
+bool checkBoidsKernels();
+
+// Vrijeme pravljenja mreze i usmjeravanja za 1k, 10k i 50k riba pri istoj gustini, za svaku podrzanu verziju
+// unutrasnje petlje, naspram O(n^2); prije mjerenja provjerava SIMD verzije i vraca false ako neka nije u granici
+bool printBoidsBenchmark();
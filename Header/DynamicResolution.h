@@ -0,0 +1,103 @@
+#pragma once
+#include <GL/glew.h>
+#include <chrono>
+
+#include "RenderTarget.h"
+#include "ShaderRegistry.h"
+
+// Kostur --dynamic-res [--res-min 0.5] [--res-max 1.0] [--res-fps 60] [--sharpen 0.5]
+struct DynamicResolutionOptions {
+    bool enabled = false;
+    float minScale = 0.5f; // Najmanja skala po svakoj osi
+    float maxScale = 1.0f; // Iznad 1 se, kad ima vremena, crta u vecoj rezoluciji i umanjuje (supersampling)
+    double targetFps = 0; // 0 = brzina frejmova iz FramePacer-a
+    float sharpness = 0.5f; // Izostravanje pri uvecanju, 0 = samo bilinearno
+};
+
+DynamicResolutionOptions parseDynamicResolution(int argc, char** argv);
+
+struct DynamicResolutionStats {
+    unsigned long long frames = 0;
+    unsigned long long changes = 0; // Koliko puta je skala promijenjena
+    double averageScale = 0;
+    float minScale = 1.0f; // Najmanja skala koja je stvarno koriscena
+    double averageFrameMs = 0; // Izmjereno vrijeme frejma (vece od CPU i GPU vremena)
+    double upscaleMs = 0; // Procjena cijene uvecanja
+};
+
+// Scena se crta u teksturu manje rezolucije, pa se uvecava u izlazni framebuffer. Tekstura se pravi za najvecu
+// skalu i crta se samo u njen dio (viewport), pa promjena skale ne trazi novu teksturu. U punoj rezoluciji se
+// crta direktno u izlaz, bez teksture i uvecanja.
+// Skalu vodi izglacano vrijeme, posebno za scenu i za uvecanje: vece od CPU vremena i GPU vremena (GL_TIMESTAMP
+// upiti procitani par frejmova kasnije). Scena kosta priblizno srazmjerno broju piksela, a uvecanje stalno (zavisi
+// od izlaza), pa se nova skala bira po procjeni ukupne cijene; brzo se smanjuje, a polako vraca na punu rezoluciju.
+// Na softverskom crtanju uvecanje moze da kosta vise nego sto smanjenje stedi, pa tada skala ostaje puna.
+class DynamicResolution {
+public:
+    static const int FRAME_LATENCY = 4;
+
+    DynamicResolution() = default;
+    ~DynamicResolution();
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    bool create(ShaderRegistry& shaders, const DynamicResolutionOptions& options, double pacerFps);
+    void destroy();
+
+    // Vezuje teksturu smanjene rezolucije (ili sam izlaz, u punoj rezoluciji) za crtanje;
+    // outputFramebuffer je framebuffer u koji se uvecava (0 = prozor)
+    void beginFrame(GLuint outputFramebuffer, int outputWidth, int outputHeight);
+    // Uvecava sliku u izlaz, ostavlja ga vezanog i azurira skalu
+    void endFrame();
+
+    float getScale() const { return scale; }
+    int getRenderWidth() const { return renderWidth; }
+    int getRenderHeight() const { return renderHeight; }
+    DynamicResolutionStats getStats() const;
+    void printReport() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    enum Timestamp { FRAME_BEGIN, UPSCALE_BEGIN, FRAME_END, TIMESTAMP_COUNT };
+
+    void collectGpuTime();
+    void readUniformLocations();
+    void updateScale(double sceneMs, double upscaleMs);
+    double predictMs(float candidate) const;
+
+    DynamicResolutionOptions options;
+    RenderTarget target;
+    ShaderRegistry* shaders = nullptr;
+    int program = -1; // Oznaka u ShaderRegistry
+    GLint sourceLocation = -1;
+    GLint uvScaleLocation = -1;
+    GLint sharpnessLocation = -1;
+    unsigned locationsReload = 0; // getReloadCount kad su lokacije procitane
+    GLuint vertexArray = 0;
+    GLuint queries[FRAME_LATENCY][TIMESTAMP_COUNT] = {};
+    bool queryPending[FRAME_LATENCY] = {};
+    bool queryUpscaled[FRAME_LATENCY] = {};
+    int currentQuery = 0;
+    Clock::time_point frameStart;
+    double gpuSceneMs = 0;
+    double gpuUpscaleMs = 0;
+
+    GLuint outputFramebuffer = 0;
+    bool direct = true; // Ovaj frejm se crta direktno u izlaz
+    int outputWidth = 0;
+    int outputHeight = 0;
+    int renderWidth = 0;
+    int renderHeight = 0;
+    float scale = 1.0f;
+    double budgetMs = 1000.0 / 60.0;
+    double smoothedSceneMs = 0;
+    double smoothedUpscaleMs = 0;
+    int framesSinceChange = 0;
+
+    unsigned long long frames = 0;
+    unsigned long long changes = 0;
+    double scaleSum = 0;
+    double frameMsSum = 0;
+    float lowestScale = 1.0f;
+};
@@ -0,0 +1,168 @@
+#pragma once
+// Generisano iz foldera Shaders (Tools/EmbedShaders.ps1, pre-build korak). Ne mijenjati rucno.
+#include "Hash.h"
+#include "ShaderSources.h"
+
+// Shaders/fish.frag
+static constexpr char EMBEDDED_FISH_FRAG[] =
+    R"glsl(#version 330 core
+#include "frame.glsl"
+
+in vec4 chCol;
+out vec4 outCol;
+
+#ifdef TEXTURED
+uniform sampler2D uTexture;
+in vec2 chUv;
+#endif
+
+void main()
+{
+    vec4 color = chCol;
+#ifdef TEXTURED
+    //Tekstura daje sare, a boja ribe je i dalje boji
+    color *= texture(uTexture, chUv);
+#endif
+    //Dublje ribe su malo vise u boji vode
+    float depth = clamp((uWaterLevel - gl_FragCoord.y / uResolution.y * 2.0 + 1.0) * 0.25, 0.0, 0.5);
+    outCol = vec4(mix(color.rgb, uWaterColor.rgb, depth), color.a);
+}
+)glsl"
+    ;
+
+// Shaders/fish.vert
+static constexpr char EMBEDDED_FISH_VERT[] =
+    R"glsl(#version 330 core
+#include "frame.glsl"
+
+layout(location = 0) in vec2 inPos;
+layout(location = 1) in vec4 inCol;
+out vec4 chCol;
+
+#ifdef TEXTURED
+layout(location = 2) in vec2 inUv;
+out vec2 chUv;
+#endif
+
+void main()
+{
+    gl_Position = uViewProjection * vec4(inPos, 0.0, 1.0);
+    chCol = inCol;
+#ifdef TEXTURED
+    chUv = inUv;
+#endif
+}
+)glsl"
+    ;
+
+// Shaders/frame.glsl
+static constexpr char EMBEDDED_FRAME_GLSL[] =
+    R"glsl(// Podaci frejma zajednicki za sve programe (FrameUniforms.h, vezivanje 0). Ukljucuje se sa #include "frame.glsl"
+layout(std140) uniform FrameData
+{
+    mat4 uViewProjection;
+    float uTime;
+    float uDeltaTime;
+    vec2 uResolution;
+    vec4 uWaterColor;
+    float uWaterLevel;
+    float uWaveAmplitude;
+    float uWaveFrequency;
+    float uWaveSpeed;
+};
+)glsl"
+    ;
+
+// Shaders/overlay.frag
+static constexpr char EMBEDDED_OVERLAY_FRAG[] =
+    R"glsl(#version 330 core
+
+in vec4 chCol;
+out vec4 outCol;
+
+void main()
+{
+    outCol = chCol;
+}
+)glsl"
+    ;
+
+// Shaders/overlay.vert
+static constexpr char EMBEDDED_OVERLAY_VERT[] =
+    R"glsl(#version 330 core
+
+layout(location = 0) in vec2 inPos;
+layout(location = 1) in vec4 inCol;
+out vec4 chCol;
+
+void main()
+{
+    gl_Position = vec4(inPos, 0.0, 1.0);
+    chCol = inCol;
+}
+)glsl"
+    ;
+
+// Shaders/upscale.frag
+static constexpr char EMBEDDED_UPSCALE_FRAG[] =
+    R"glsl(#version 330 core
+
+uniform sampler2D uSource;
+uniform vec2 uUvScale;
+uniform float uSharpness; // 0 = samo bilinearno
+in vec2 chUv;
+out vec4 outCol;
+
+vec3 sampleArea(vec2 uv, vec2 texel)
+{
+    //Van dijela u koji je crtano su ostaci vecih frejmova, pa se uzorci drze pola teksela unutra
+    return texture(uSource, clamp(uv, texel * 0.5, uUvScale - texel * 0.5)).rgb;
+}
+
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(uSource, 0));
+    vec3 color = sampleArea(chUv, texel);
+    if (uSharpness > 0.0)
+    {
+        //Izostravanje: razlika od susjednih teksela, ograniceno njihovim opsegom da ne nastanu oreoli oko ivica
+        vec3 north = sampleArea(chUv + vec2(0.0, texel.y), texel);
+        vec3 south = sampleArea(chUv - vec2(0.0, texel.y), texel);
+        vec3 east = sampleArea(chUv + vec2(texel.x, 0.0), texel);
+        vec3 west = sampleArea(chUv - vec2(texel.x, 0.0), texel);
+        vec3 low = min(min(north, south), min(east, west));
+        vec3 high = max(max(north, south), max(east, west));
+        vec3 sharpened = color + (4.0 * color - north - south - east - west) * uSharpness * 0.25;
+        color = clamp(sharpened, min(low, color), max(high, color));
+    }
+    outCol = vec4(color, 1.0);
+}
+)glsl"
+    ;
+
+// Shaders/upscale.vert
+static constexpr char EMBEDDED_UPSCALE_VERT[] =
+    R"glsl(#version 330 core
+
+uniform vec2 uUvScale; // Dio teksture u koji je crtano (velicina crtanja kroz velicinu teksture)
+out vec2 chUv;
+
+void main()
+{
+    //Jedan trougao preko cijelog ekrana, bez bafera temena
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    chUv = corner * uUvScale;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+)glsl"
+    ;
+
+static constexpr ShaderSource EMBEDDED_SHADERS[] = {
+    { "Shaders/fish.frag", EMBEDDED_FISH_FRAG, sizeof(EMBEDDED_FISH_FRAG) - 1, hashLiteral(EMBEDDED_FISH_FRAG, sizeof(EMBEDDED_FISH_FRAG) - 1) },
+    { "Shaders/fish.vert", EMBEDDED_FISH_VERT, sizeof(EMBEDDED_FISH_VERT) - 1, hashLiteral(EMBEDDED_FISH_VERT, sizeof(EMBEDDED_FISH_VERT) - 1) },
+    { "Shaders/frame.glsl", EMBEDDED_FRAME_GLSL, sizeof(EMBEDDED_FRAME_GLSL) - 1, hashLiteral(EMBEDDED_FRAME_GLSL, sizeof(EMBEDDED_FRAME_GLSL) - 1) },
+    { "Shaders/overlay.frag", EMBEDDED_OVERLAY_FRAG, sizeof(EMBEDDED_OVERLAY_FRAG) - 1, hashLiteral(EMBEDDED_OVERLAY_FRAG, sizeof(EMBEDDED_OVERLAY_FRAG) - 1) },
+    { "Shaders/overlay.vert", EMBEDDED_OVERLAY_VERT, sizeof(EMBEDDED_OVERLAY_VERT) - 1, hashLiteral(EMBEDDED_OVERLAY_VERT, sizeof(EMBEDDED_OVERLAY_VERT) - 1) },
+    { "Shaders/upscale.frag", EMBEDDED_UPSCALE_FRAG, sizeof(EMBEDDED_UPSCALE_FRAG) - 1, hashLiteral(EMBEDDED_UPSCALE_FRAG, sizeof(EMBEDDED_UPSCALE_FRAG) - 1) },
+    { "Shaders/upscale.vert", EMBEDDED_UPSCALE_VERT, sizeof(EMBEDDED_UPSCALE_VERT) - 1, hashLiteral(EMBEDDED_UPSCALE_VERT, sizeof(EMBEDDED_UPSCALE_VERT) - 1) },
+};
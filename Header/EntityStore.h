@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+static const unsigned ENTITY_INVALID_INDEX = 0xFFFFFFFFu;
+
+// Oznaka entiteta: indeks i generacija. Indeks obrisanog entiteta se ponovo koristi sa vecom generacijom,
+// pa stara oznaka (npr. meta ribe, hrana koju je pojela druga riba) vise ne vazi umjesto da pokazuje na novi entitet.
+struct Entity {
+    unsigned index = ENTITY_INVALID_INDEX;
+    unsigned generation = 0;
+
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+class ComponentPoolBase {
+public:
+    virtual ~ComponentPoolBase() = default;
+    virtual void remove(Entity entity) = 0;
+};
+
+// Jedna vrsta komponente za sve entitete: gust niz komponenti (bez rupa) i paralelan niz njihovih entiteta,
+// plus rijedak niz indeks entiteta -> pozicija u gustom nizu. Brisanje premjesta poslednji element na mjesto
+// obrisanog (swap-remove), pa petlje uvijek idu redom kroz memoriju.
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+    // Ako entitet vec ima komponentu, zamjenjuje je
+    T& add(Entity entity, const T& value = T())
+    {
+        if (entity.index >= sparse.size()) sparse.resize(entity.index + 1, ENTITY_INVALID_INDEX);
+        unsigned& slot = sparse[entity.index];
+        if (slot != ENTITY_INVALID_INDEX && slot < dense.size() && dense[slot].index == entity.index)
+        {
+            dense[slot] = entity;
+            components[slot] = value;
+            return components[slot];
+        }
+        slot = (unsigned)dense.size();
+        dense.push_back(entity);
+        components.push_back(value);
+        return components.back();
+    }
+
+    void remove(Entity entity) override
+    {
+        if (!has(entity)) return;
+        unsigned slot = sparse[entity.index];
+        unsigned last = (unsigned)dense.size() - 1;
+        if (slot != last)
+        {
+            dense[slot] = dense[last];
+            components[slot] = components[last];
+            sparse[dense[slot].index] = slot;
+        }
+        dense.pop_back();
+        components.pop_back();
+        sparse[entity.index] = ENTITY_INVALID_INDEX;
+    }
+
+    bool has(Entity entity) const
+    {
+        if (entity.index >= sparse.size()) return false;
+        unsigned slot = sparse[entity.index];
+        return slot != ENTITY_INVALID_INDEX && dense[slot] == entity;
+    }
+
+    T* get(Entity entity) { return has(entity) ? &components[sparse[entity.index]] : nullptr; }
+    const T* get(Entity entity) const { return has(entity) ? &components[sparse[entity.index]] : nullptr; }
+
+    // Pristup po poziciji u gustom nizu
+    size_t size() const { return dense.size(); }
+    Entity getEntity(size_t position) const { return dense[position]; }
+    T& at(size_t position) { return components[position]; }
+    const T& at(size_t position) const { return components[position]; }
+
+    void clear()
+    {
+        dense.clear();
+        components.clear();
+        sparse.clear();
+    }
+
+    void reserve(size_t count)
+    {
+        dense.reserve(count);
+        components.reserve(count);
+    }
+
+private:
+    std::vector<T> components;
+    std::vector<Entity> dense;
+    std::vector<unsigned> sparse;
+};
+
+// Pravi i brise entitete. Entitet je samo oznaka; podaci su u ComponentPool nizovima, po jedan niz za svaku vrstu
+// komponente (struktura nizova), pa sistem koji cita samo poziciju i brzinu ne vuce kroz kes ostala polja ribe.
+// Nizovi registrovani sa registerPool se automatski ciste kad se entitet obrise.
+class EntityStore {
+public:
+    Entity create();
+    void destroy(Entity entity);
+    bool isAlive(Entity entity) const;
+    size_t getAliveCount() const { return alive; }
+
+    void registerPool(ComponentPoolBase& pool) { pools.push_back(&pool); }
+    // Brise sve entitete (registrovani nizovi se ne diraju, njih cisti vlasnik)
+    void clear();
+
+private:
+    std::vector<unsigned> generations;
+    std::vector<unsigned> freeIndices;
+    std::vector<ComponentPoolBase*> pools;
+    size_t alive = 0;
+};
+
+// Presjek komponenti: fn(entitet, a, b...) za svaki entitet koji ima sve date komponente. Ide redom kroz gust
+// niz prvog argumenta, pa prvi treba da bude najmanji. Kad su nizovi poravnati (entiteti dodavani istim redom,
+// bez brisanja), druga komponenta je na istoj poziciji i nema trazenja kroz rijedak niz.
+// fn ne smije dodavati ni brisati komponente ovih vrsta; entitete za brisanje skupiti i obrisati poslije petlje.
+template <typename A, typename Function>
+void forEach(ComponentPool<A>& a, Function fn)
+{
+    for (size_t i = 0; i < a.size(); i++) fn(a.getEntity(i), a.at(i));
+}
+
+template <typename T>
+inline T* findAligned(ComponentPool<T>& pool, size_t position, Entity entity)
+{
+    if (position < pool.size() && pool.getEntity(position) == entity) return &pool.at(position);
+    return pool.get(entity);
+}
+
+template <typename A, typename B, typename Function>
+void forEach(ComponentPool<A>& a, ComponentPool<B>& b, Function fn)
+{
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        Entity entity = a.getEntity(i);
+        B* second = findAligned(b, i, entity);
+        if (second != nullptr) fn(entity, a.at(i), *second);
+    }
+}
+
+template <typename A, typename B, typename C, typename Function>
+void forEach(ComponentPool<A>& a, ComponentPool<B>& b, ComponentPool<C>& c, Function fn)
+{
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        Entity entity = a.getEntity(i);
+        B* second = findAligned(b, i, entity);
+        if (second == nullptr) continue;
+        C* third = findAligned(c, i, entity);
+        if (third != nullptr) fn(entity, a.at(i), *second, *third);
+    }
+}
+
+// Poredi brzinu azuriranja riba u tri rasporeda: niz polimorfnih objekata razbacanih po heap-u, niz struktura
+// sa svim poljima (AoS) i komponente u EntityStore (SoA), za 1k..1M riba
+void printEntityStoreBenchmark();
@@ -0,0 +1,36 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Prati izmjene fajlova bez blokiranja. Na Linux-u koristi inotify nad folderima u kojima su fajlovi (tako se vide i
+// editori koji snimaju u privremeni fajl pa ga preimenuju), a na ostalim sistemima svakih pola sekunde poredi
+// vrijeme poslednje izmjene.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    void watch(const std::string& filePath);
+    // Putanje (kako su date u watch) fajlova izmijenjenih od prethodnog poziva, svaka najvise jednom
+    std::vector<std::string> poll();
+
+    bool isNative() const;
+
+private:
+    struct WatchedFile {
+        std::string path;
+        std::filesystem::path normalized;
+        std::filesystem::file_time_type lastWrite;
+    };
+
+    std::vector<WatchedFile> files;
+    double lastScan = 0;
+#ifdef __linux__
+    int inotifyDescriptor = -1;
+    std::unordered_map<int, std::filesystem::path> directories; // inotify watch descriptor -> folder
+#endif
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <GL/glew.h>
+#include <memory>
+#include <vector>
+
+#include "Aquarium.h"
+#include "ShaderRegistry.h"
+#include "ShaderVariants.h"
+#include "StreamBuffer.h"
+
+// Crta ribe kao trouglove (tijelo i rep koji mase) iz stanja koje je vec interpolirano izmedju dva koraka
+// simulacije, i hranu kao male kvadrate. Temena se svaki frejm pisu u StreamBuffer, pa crtanje ne ceka GPU.
+// Sa teksturom se ribe crtaju varijantom fish sejdera sa TEXTURED, a hrana uvijek obicnom.
+class FishRenderer {
+public:
+    enum Feature { TEXTURED = 1 };
+
+    bool create(ShaderRegistry& shaders, int maxFish);
+    void destroy();
+    // Tekstura ostaje u vlasnistvu pozivaoca (0 = ribe samo u boji)
+    void setTexture(GLuint newTexture) { texture = newTexture; }
+    void draw(const std::vector<FishState>& fish, const std::vector<FoodState>& food);
+
+private:
+    void bindSamplers();
+
+    ShaderRegistry* shaders = nullptr;
+    std::unique_ptr<ShaderVariants> variants;
+    int program = -1; // Oznaka u ShaderRegistry
+    int texturedProgram = -1;
+    unsigned locationsReload = 0; // getReloadCount kad je uTexture postavljen
+    GLuint texture = 0;
+    int maxFish = 0;
+    GLuint vertexArray = 0;
+    StreamBuffer vertices;
+};
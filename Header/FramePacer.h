@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+// Nacin na koji se frejmovi poravnavaju sa ekranom
+enum class FramePacingMode {
+    Vsync, // Swap ceka osvjezavanje ekrana (interval 1)
+    Adaptive, // Kao Vsync, ali zakasneli frejm se prikaze odmah, uz cijepanje slike (interval -1, ako drajver podrzava)
+    Capped, // Bez vsync-a, najvise targetFps frejmova u sekundi (spavanje pa kratko vrtenje do tacnog trenutka)
+    LowLatency, // Vsync, ali ulaz i simulacija se odlazu do trenutka kad je frejm taman gotov prije sledeceg osvjezavanja
+    Uncapped, // Bez vsync-a i bez ogranicenja
+};
+
+struct FrameTimeStats {
+    unsigned long long frames = 0;
+    double averageMs = 0; // Vrijeme od swap-a do swap-a
+    double p50Ms = 0;
+    double p95Ms = 0;
+    double p99Ms = 0;
+    double maxMs = 0;
+    double jitterMs = 0; // Standardna devijacija
+    double workMs = 0; // Prosjecno vrijeme rada procesora u frejmu (bez cekanja)
+    unsigned long long missed = 0; // Frejmovi duzi od 1.5 ciljanog intervala
+};
+
+// Tempo frejmova. Redosljed poziva u petlji:
+//   waitForFrameStart(); glfwPollEvents(); simulacija i crtanje; beforeSwap(); glfwSwapBuffers(); afterSwap();
+// Za svaki nacin se pamte vremena frejmova, pa se na kraju moze uporediti koji je najbolji za dati ekran.
+class FramePacer {
+public:
+    void init(FramePacingMode mode, double targetFps = 0);
+
+    // LowLatency: spava do predvidjenog pocetka frejma
+    void waitForFrameStart();
+    // Capped: spava i vrti se do trenutka sledeceg frejma
+    void beforeSwap();
+    void afterSwap();
+
+    FramePacingMode getMode() const { return mode; }
+    double getTargetFps() const { return 1.0 / targetInterval; }
+    FrameTimeStats getStats() const;
+    void printReport() const;
+
+    static const char* modeName(FramePacingMode mode);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void preciseSleepUntil(Clock::time_point target);
+
+    FramePacingMode mode = FramePacingMode::Vsync;
+    double targetInterval = 1.0 / 60.0;
+    Clock::time_point frameStart;
+    Clock::time_point lastSwap;
+    bool hasLastSwap = false;
+    Clock::time_point swapDeadline; // Capped: trenutak sledeceg swap-a
+    bool hasSwapDeadline = false;
+    double sleepOvershoot = 0.001; // Najvise sto je sleep zakasnio (polako opada), toliko se prije kraja vrti
+    double predictedWork = 0.004; // Procjena trajanja rada u frejmu (LowLatency)
+    std::vector<float> frameTimes; // Prstenasti niz poslednjih frejmova, u ms
+    size_t nextFrameTime = 0;
+    unsigned long long frames = 0;
+    unsigned long long missed = 0;
+    double totalWork = 0;
+    unsigned long long workFrames = 0;
+};
+
+// --pacing vsync|adaptive|cap|low-latency|uncapped (--no-vsync je isto sto i uncapped), --fps-cap N za cap
+FramePacingMode parseFramePacing(int argc, char** argv, double& targetFps);
@@ -0,0 +1,42 @@
+#pragma once
+
+struct FrameSchedulerStats {
+    unsigned long long frames = 0;
+    unsigned long long ticks = 0;
+    unsigned long long clampedFrames = 0; // Frejmovi u kojima je dostignut maxTicksPerFrame ili maxFrameSeconds
+    double droppedSeconds = 0; // Vrijeme koje simulacija nije nadoknadila (usporava umjesto da se zaglavi)
+    int maxTicksInFrame = 0;
+};
+
+// Simulacija napreduje fiksnim korakom (npr. 60 ili 120 Hz), nezavisno od brzine crtanja.
+// Proteklo vrijeme frejma se dodaje u akumulator, iz kog se izvrsi onoliko koraka koliko stane; ostatak
+// (alpha = ostatak / korak) sluzi za interpolaciju izmedju poslednja dva stanja pri crtanju.
+// Zastita od "spirale smrti": ako je frejm bio predug (debuger, prevlacenje prozora, spor korak simulacije),
+// proteklo vrijeme se ogranicava na maxFrameSeconds, a broj koraka po frejmu na maxTicksPerFrame;
+// visak se odbacuje, pa simulacija privremeno usporava umjesto da svaki sledeci frejm bude jos duzi.
+class FrameScheduler {
+public:
+    explicit FrameScheduler(double tickRate = 60.0, int maxTicksPerFrame = 8, double maxFrameSeconds = 0.25);
+
+    // Dodaje proteklo vrijeme frejma (u sekundama) i vraca broj koraka simulacije koje treba izvrsiti
+    int advance(double frameSeconds);
+    // Isto, a proteklo vrijeme racuna iz apsolutnog vremena (npr. glfwGetTime); prvi poziv ne izvrsava korake
+    int advanceTo(double now);
+
+    double getTickSeconds() const { return tickSeconds; }
+    double getTickRate() const { return 1.0 / tickSeconds; }
+    // Udio do sledeceg koraka, [0, 1): 0 je poslednje izracunato stanje, 1 bi bio sledeci korak
+    float getAlpha() const { return (float)(accumulator / tickSeconds); }
+    const FrameSchedulerStats& getStats() const { return stats; }
+
+private:
+    double tickSeconds;
+    int maxTicksPerFrame;
+    double maxFrameSeconds;
+    double accumulator = 0;
+    double lastTime = -1;
+    FrameSchedulerStats stats;
+};
+
+// Korak simulacije iz komandne linije: "--tick-rate 120" (podrazumijevano 60)
+double parseTickRate(int argc, char** argv, double defaultRate = 60.0);
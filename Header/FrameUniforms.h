@@ -0,0 +1,46 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+#include "StreamBuffer.h"
+
+// Ime uniform bloka u sejderima (Shaders/frame.glsl) i tacka vezivanja koju dijele svi programi
+static const char FRAME_UNIFORM_BLOCK[] = "FrameData";
+static const GLuint FRAME_UNIFORM_BINDING = 0;
+
+// Podaci koji su isti za sve programe u jednom frejmu, raspored po std140 pravilima (mora se poklapati sa frame.glsl)
+struct FrameUniformData {
+    float viewProjection[16]; // mat4, po kolonama
+    float time; // Sekunde od pokretanja
+    float deltaTime;
+    float resolution[2]; // Velicina framebuffer-a u pikselima
+    float waterColor[4];
+    float waterLevel; // Visina povrsine vode u NDC
+    float waveAmplitude;
+    float waveFrequency;
+    float waveSpeed;
+};
+static_assert(offsetof(FrameUniformData, time) == 64, "std140: float iza mat4");
+static_assert(offsetof(FrameUniformData, resolution) == 72, "std140: vec2 poravnat na 8");
+static_assert(offsetof(FrameUniformData, waterColor) == 80, "std140: vec4 poravnat na 16");
+static_assert(sizeof(FrameUniformData) == 112, "std140: velicina bloka FrameData");
+
+// Uniform bafer sa FrameUniformData koji se puni jednom po frejmu i vezuje jednom za FRAME_UNIFORM_BINDING,
+// umjesto da se isti podaci postavljaju kroz glUniform u svakom programu. Ide kroz StreamBuffer, pa upis
+// ne ceka GPU koji jos cita podatke prethodnog frejma.
+class FrameUniforms {
+public:
+    bool create();
+    void destroy();
+
+    void update(const FrameUniformData& data);
+    // Poziva se kad su sva crtanja u frejmu poslata
+    void endFrame();
+
+private:
+    StreamBuffer buffer;
+    size_t alignment = 256;
+};
+
+// Jedinicna matrica (kad jos nema kamere)
+void setIdentityMatrix(float matrix[16]);
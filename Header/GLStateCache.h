@@ -0,0 +1,90 @@
+#pragma once
+#include <GL/glew.h>
+
+// Broj poziva koji su stvarno poslati drajveru i onih koji su preskoceni jer bi postavili vec postavljeno stanje
+struct GLStateCounters {
+    unsigned long long issued = 0;
+    unsigned long long skipped = 0;
+};
+
+// Tanak sloj iznad OpenGL-a koji pamti vezani program, teksture po jedinicama, VAO, bafere, framebuffer i
+// blend/depth stanje, pa preskace pozive koji nista ne mijenjaju (svaki takav poziv drajver ipak validira).
+// Sav kod koji mijenja ovo stanje treba da ide kroz kes; ako neki kod zaobidje kes, posle njega pozvati invalidate().
+class GLStateCache {
+public:
+    static const int MAX_TEXTURE_UNITS = 16;
+
+    GLStateCache();
+
+    // Zaboravlja sve zapamceno stanje, pa ce sledeci poziv svake vrste sigurno otici drajveru
+    void invalidate();
+    // Poziva se na pocetku frejma: brojaci tekuceg frejma se pamte kao brojaci prethodnog
+    void beginFrame();
+
+    void useProgram(GLuint program);
+    void activeTexture(GLuint unit); // unit je redni broj (0, 1, ...), ne GL_TEXTUREi
+    void bindTexture(GLenum target, GLuint texture); // Na trenutno aktivnoj jedinici
+    void bindTextureUnit(GLuint unit, GLenum target, GLuint texture);
+    void bindVertexArray(GLuint vertexArray);
+    void bindBuffer(GLenum target, GLuint buffer);
+    void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size); // Uvijek se salje
+    void bindFramebuffer(GLenum target, GLuint framebuffer);
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void setEnabled(GLenum capability, bool enabled);
+    void blendFunc(GLenum source, GLenum destination);
+    void depthFunc(GLenum function);
+    void depthMask(GLboolean mask);
+
+    // Brisanje objekata mora ici kroz kes, jer OpenGL moze ponovo dati isto ime novom objektu
+    void deleteTexture(GLuint texture);
+    void deleteProgram(GLuint program);
+    void deleteVertexArray(GLuint vertexArray);
+    void deleteBuffer(GLuint buffer);
+    void deleteFramebuffer(GLuint framebuffer);
+
+    const GLStateCounters& getFrameCounters() const { return currentFrame; }
+    const GLStateCounters& getLastFrameCounters() const { return lastFrame; }
+    const GLStateCounters& getTotalCounters() const { return total; }
+
+private:
+    enum TextureTarget { TEXTURE_2D, TEXTURE_2D_ARRAY, TEXTURE_CUBE_MAP, TEXTURE_TARGET_COUNT };
+    enum BufferTarget { ARRAY_BUFFER, ELEMENT_ARRAY_BUFFER, UNIFORM_BUFFER, PIXEL_UNPACK_BUFFER, PIXEL_PACK_BUFFER, BUFFER_TARGET_COUNT };
+    enum Capability { BLEND, DEPTH_TEST, CULL_FACE, SCISSOR_TEST, STENCIL_TEST, CAPABILITY_COUNT };
+    static const int MAX_UNIFORM_BUFFER_BINDINGS = 16;
+
+    // Vrijednost koju OpenGL nikad ne vraca, znaci "ne znamo sta je postavljeno"
+    static const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+    static int textureTargetIndex(GLenum target);
+    static int bufferTargetIndex(GLenum target);
+    static int capabilityIndex(GLenum capability);
+
+    // Vraca true ako poziv treba poslati drajveru (i azurira brojace)
+    bool change(GLuint& cached, GLuint value);
+    void countIssued() { currentFrame.issued++; total.issued++; }
+    void countSkipped() { currentFrame.skipped++; total.skipped++; }
+
+    GLuint program;
+    GLuint activeUnit;
+    GLuint textures[MAX_TEXTURE_UNITS][TEXTURE_TARGET_COUNT];
+    GLuint vertexArray;
+    GLuint buffers[BUFFER_TARGET_COUNT];
+    GLuint uniformBufferBindings[MAX_UNIFORM_BUFFER_BINDINGS];
+    GLuint drawFramebuffer;
+    GLuint readFramebuffer;
+    GLint viewportRect[4];
+    GLuint capabilities[CAPABILITY_COUNT];
+    GLuint blendSource, blendDestination;
+    GLuint depthFunction;
+    GLuint depthWrite;
+
+    GLStateCounters currentFrame;
+    GLStateCounters lastFrame;
+    GLStateCounters total;
+};
+
+// Kes stanja konteksta koji je trenutno aktivan na ovoj niti
+GLStateCache& glState();
+// Svaki OpenGL kontekst ima svoje stanje; pri glfwMakeContextCurrent treba postaviti i njegov kes
+void setCurrentGLState(GLStateCache* state);
@@ -0,0 +1,108 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ShaderRegistry.h"
+#include "StreamBuffer.h"
+
+// Statistika jednog prolaza (render pass-a) u milisekundama, iz poslednjih GpuProfiler::HISTORY_SIZE frejmova
+struct GpuPassStats {
+    std::string name;
+    unsigned long long samples = 0; // Ukupno izmjerenih frejmova
+    double lastMs = 0;
+    double averageMs = 0;
+    double p50Ms = 0;
+    double p95Ms = 0;
+    double p99Ms = 0;
+    double maxMs = 0;
+};
+
+// Mjerenje vremena na GPU po prolazima pomocu GL_TIMESTAMP upita (glQueryCounter; za razliku od GL_TIME_ELAPSED mogu se ugnjezdavati). Upiti se uzimaju iz bazena,
+// a rezultati se citaju tek nekoliko frejmova kasnije i samo ako su spremni, pa mjerenje nikad ne zaustavlja CPU.
+// Prolazi mogu biti ugnjezdeni; cijeli frejm se mjeri kao prolaz "frame".
+class GpuProfiler {
+public:
+    static const int FRAME_LATENCY = 4; // Koliko frejmova rezultati smiju da kasne prije nego sto se frejm odbaci
+    static const int HISTORY_SIZE = 240; // Broj frejmova iz kojih se racunaju prosjek i percentili
+
+    GpuProfiler() = default;
+    ~GpuProfiler();
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+    void beginPass(const char* name);
+    void endPass();
+
+    std::vector<GpuPassStats> getStats() const;
+    unsigned long long getDroppedFrames() const { return droppedFrames; }
+
+    bool writeCsv(const char* filePath) const;
+    bool writeJson(const char* filePath) const;
+
+private:
+    struct PassQuery {
+        int pass;
+        GLuint begin;
+        GLuint end;
+    };
+    struct PendingFrame {
+        std::vector<PassQuery> queries;
+        bool pending = false;
+    };
+    struct PassHistory {
+        std::string name;
+        std::vector<float> samples; // Prstenasti niz poslednjih HISTORY_SIZE mjerenja
+        size_t next = 0;
+        unsigned long long total = 0;
+        float last = 0;
+    };
+
+    GLuint acquireQuery();
+    int passIndex(const char* name);
+    bool collect(PendingFrame& frame);
+    void release(PendingFrame& frame);
+
+    std::vector<GLuint> freeQueries;
+    std::vector<GLuint> allQueries;
+    PendingFrame frames[FRAME_LATENCY];
+    int currentFrame = 0;
+    bool inFrame = false;
+    std::vector<size_t> openPasses; // Indeksi u frames[currentFrame].queries za prolaze koji jos traju
+    std::vector<PassHistory> passes;
+    std::unordered_map<std::string, int> passIndices;
+    unsigned long long droppedFrames = 0;
+};
+
+// Mjeri prolaz od konstrukcije do kraja bloka: { GpuScope scope(profiler, "voda"); ... }
+class GpuScope {
+public:
+    GpuScope(GpuProfiler& profiler, const char* name) : profiler(profiler) { profiler.beginPass(name); }
+    ~GpuScope() { profiler.endPass(); }
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+
+private:
+    GpuProfiler& profiler;
+};
+
+// Prikaz na ekranu: za svaki prolaz traka duzine prosjecnog vremena (i tanja traka do p95),
+// gdje je cijela sirina jedan frejm od 60 Hz. Imena i brojevi se ispisuju preko formatSummary.
+class GpuProfilerOverlay {
+public:
+    bool create(ShaderRegistry& shaders);
+    void destroy();
+    void draw(const std::vector<GpuPassStats>& stats);
+
+    // Kratak tekstualni pregled (npr. za naslov prozora): "frame 2.1 ms | voda 0.8 ms | ..."
+    static std::string formatSummary(const std::vector<GpuPassStats>& stats);
+
+private:
+    ShaderRegistry* shaders = nullptr;
+    int program = -1; // Oznaka u ShaderRegistry
+    GLuint vertexArray = 0;
+    StreamBuffer vertices;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstring>
+#include <string>
+
+// Brza 64-bitna hes funkcija (MurmurHash64A) za kljuceve keseva, nije kriptografska
+inline unsigned long long hashBytes(const void* data, size_t size, unsigned long long seed = 0)
+{
+    const unsigned long long m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    unsigned long long h = seed ^ (size * m);
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    const unsigned char* end = bytes + (size / 8) * 8;
+    for (; bytes != end; bytes += 8)
+    {
+        unsigned long long k;
+        memcpy(&k, bytes, 8); //memcpy jer podaci ne moraju biti poravnati
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    switch (size & 7)
+    {
+    case 7: h ^= (unsigned long long)bytes[6] << 48; // fall through
+    case 6: h ^= (unsigned long long)bytes[5] << 40; // fall through
+    case 5: h ^= (unsigned long long)bytes[4] << 32; // fall through
+    case 4: h ^= (unsigned long long)bytes[3] << 24; // fall through
+    case 3: h ^= (unsigned long long)bytes[2] << 16; // fall through
+    case 2: h ^= (unsigned long long)bytes[1] << 8; // fall through
+    case 1: h ^= (unsigned long long)bytes[0];
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+inline unsigned long long hashString(const std::string& text, unsigned long long seed = 0)
+{
+    return hashBytes(text.data(), text.size(), seed);
+}
+
+// Hes kao heksadecimalni string od 16 znakova (za imena fajlova u kesu)
+inline std::string hashToHex(unsigned long long hash)
+{
+    const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; i--)
+    {
+        hex[i] = digits[hash & 0xf];
+        hash >>= 4;
+    }
+    return hex;
+}
+
+// Isti hes kao hashBytes, ali se moze izracunati pri prevodjenju (npr. za kod ugradjenih sejdera)
+constexpr unsigned long long hashLiteral(const char* text, size_t size, unsigned long long seed = 0)
+{
+    const unsigned long long m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    unsigned long long h = seed ^ (size * m);
+
+    size_t blocks = size / 8;
+    for (size_t block = 0; block < blocks; block++)
+    {
+        unsigned long long k = 0;
+        for (int byte = 7; byte >= 0; byte--) k = (k << 8) | (unsigned char)text[block * 8 + byte]; //Little-endian, kao memcpy na x86
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    size_t tail = size & 7;
+    if (tail > 0)
+    {
+        for (size_t byte = tail; byte > 0; byte--) h ^= (unsigned long long)(unsigned char)text[blocks * 8 + byte - 1] << (8 * (byte - 1));
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <GLFW/glfw3.h>
+#include <string>
+
+// Crtanje bez ekrana (CI, serveri bez monitora, mjerenje na Mesa llvmpipe):
+//   Kostur --headless [--size 1920x1080] [--frames 300] [--dump slika.ppm]
+// Scena se crta u framebuffer zadate velicine umjesto u prozor, tacno "frames" frejmova, sa simulacijom
+// koja u svakom frejmu napreduje za jedan korak (isti rezultat pri svakom pokretanju), bez cekanja na ekran.
+struct HeadlessOptions {
+    bool enabled = false;
+    int width = 800;
+    int height = 800;
+    int frames = 300;
+    std::string dumpPath; // Prazno = bez upisa poslednjeg frejma
+};
+
+HeadlessOptions parseHeadlessOptions(int argc, char** argv);
+
+// Inicijalizuje GLFW i pravi nevidljiv prozor sa OpenGL 3.3 kontekstom. Ako prozor ne moze da se napravi
+// (nema ekrana), pokusava GLFW "null" platformu sa OSMesa kontekstom, koji ne treba nikakav ekran.
+GLFWwindow* createHeadlessWindow();
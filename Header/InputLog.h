@@ -0,0 +1,67 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Aquarium.h"
+
+// Snimak ulaza za poredjenje brzine dve verzije programa na istom poslu:
+//   Kostur --record ulaz.bin [--seed 1234]   snima sve dogadjaje koje je simulacija primila
+//   Kostur --replay ulaz.bin [--headless]    pusta ih ponovo, korak po korak, najbrze sto moze
+// Dogadjaji nose korak simulacije u kom su primijenjeni (ne vrijeme), pa je reprodukcija tacna bez obzira na
+// brzinu masine. Format: zaglavlje (oznaka, verzija, seme, broj riba, koraci u sekundi, poslednji korak, broj
+// dogadjaja), pa dogadjaji: razlika koraka (varint), tip, podaci (koordinate kao sirovi bitovi float-a).
+struct InputLogOptions {
+    std::string recordPath; // Prazno = bez snimanja
+    std::string replayPath; // Prazno = bez reprodukcije
+    unsigned seed = 0; // 0 = podrazumijevano seme programa
+};
+
+InputLogOptions parseInputLogOptions(int argc, char** argv);
+
+struct InputLogEvent {
+    unsigned long long tick;
+    AquariumInput input;
+};
+
+// Skuplja dogadjaje u memoriji (poziva ga Aquarium::apply, iz niti simulacije), a upisuje ih na kraju
+class InputRecorder {
+public:
+    void begin(unsigned seed, int fishCount, double tickRate);
+    void record(unsigned long long tick, const AquariumInput& input);
+    // endTick: korak do kog je simulacija stigla; reprodukcija ide tacno do njega
+    bool save(const char* path, unsigned long long endTick) const;
+
+    size_t getEventCount() const { return events.size(); }
+
+private:
+    std::vector<InputLogEvent> events;
+    unsigned seed = 0;
+    int fishCount = 0;
+    double tickRate = 60.0;
+};
+
+class InputReplay {
+public:
+    bool load(const char* path);
+
+    unsigned getSeed() const { return seed; }
+    int getFishCount() const { return fishCount; }
+    double getTickRate() const { return tickRate; }
+    unsigned long long getEndTick() const { return endTick; }
+    size_t getEventCount() const { return events.size(); }
+
+    // Primjenjuje sve dogadjaje snimljene za trenutni korak akvarijuma; poziva se prije svakog step
+    void applyDue(Aquarium& aquarium);
+    bool isFinished(const Aquarium& aquarium) const { return aquarium.getTick() >= endTick; }
+
+private:
+    std::vector<InputLogEvent> events;
+    size_t next = 0;
+    unsigned seed = 0;
+    int fishCount = 0;
+    double tickRate = 60.0;
+    unsigned long long endTick = 0;
+};
+
+// Hes stanja svih riba: isti snimak mora dati isti broj u svakoj verziji programa
+unsigned long long aquariumChecksum(const Aquarium& aquarium);
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+// Brojac nezavrsenih poslova. Svaki posao pokrenut sa brojacem ga povecava, a po zavrsetku smanjuje;
+// wait(brojac) radi druge poslove dok brojac ne padne na nulu. Poslovi dodati sa runAfter se pokrecu
+// kad brojac sledeci put padne na nulu (zavisnosti izmedju grupa poslova).
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    struct Job;
+
+    std::atomic<int> pending{ 0 };
+    std::mutex mutex;
+    std::vector<Job*> continuations;
+};
+
+struct JobSystemStats {
+    unsigned long long executed = 0;
+    unsigned long long stolen = 0; // Poslovi koje je nit uzela iz tudjeg reda
+    unsigned long long inlined = 0; // Poslovi izvrseni odmah jer je red bio pun
+};
+
+// Fiksan skup radnih niti. Svaka nit (i nit koja je napravila sistem, indeks 0) ima svoj Chase-Lev red:
+// vlasnik dodaje i uzima sa dna bez zakljucavanja, a ostale niti kradu sa vrha kad ostanu bez posla.
+// Niti van sistema (npr. nit simulacije) dodaju poslove u zajednicki red sa mutexom.
+// Koristi se za sve sto se dijeli na nezavisne dijelove: kodiranje blokova tekstura, mip nivoe, azuriranje riba.
+class JobSystem {
+public:
+    // threadCount ukljucuje nit koja pravi sistem; 0 = broj jezgara procesora
+    explicit JobSystem(unsigned threadCount = 0);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void run(std::function<void()> work, JobCounter* counter = nullptr);
+    // Pokrece posao tek kad dependency padne na nulu (odmah, ako je vec na nuli)
+    void runAfter(JobCounter& dependency, std::function<void()> work, JobCounter* counter = nullptr);
+    // Izvrsava druge poslove dok brojac ne padne na nulu
+    void wait(JobCounter& counter);
+
+    // Dijeli [begin, end) na dijelove od najmanje grain indeksa i poziva body(pocetak, kraj) za svaki,
+    // paralelno; vraca se kad su svi dijelovi gotovi
+    void parallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body);
+
+    unsigned getThreadCount() const { return (unsigned)queues.size(); }
+    JobSystemStats getStats() const;
+
+private:
+    typedef JobCounter::Job Job;
+    class WorkQueue;
+
+    int currentIndex() const;
+    void push(Job* job);
+    Job* findJob(int index);
+    void execute(Job* job);
+    void finish(JobCounter* counter);
+    void wakeWorkers(bool all);
+    void workerLoop(int index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::thread::id ownerThread;
+
+    std::mutex injectMutex;
+    std::deque<Job*> injected; // Poslovi iz niti van sistema
+    std::atomic<int> injectedCount{ 0 };
+
+    std::atomic<int> queued{ 0 }; // Poslovi u redovima koje jos niko nije uzeo; uspavana nit se budi tek kad je > 0
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    std::atomic<int> sleeping{ 0 };
+    std::atomic<bool> stopping{ false };
+
+    std::atomic<unsigned long long> executed{ 0 };
+    std::atomic<unsigned long long> stolen{ 0 };
+    std::atomic<unsigned long long> inlined{ 0 };
+};
+
+// Zajednicki sistem poslova programa (pravi se pri prvom pozivu, iz glavne niti)
+JobSystem& jobSystem();
+
+// Mjeri ubrzanje sa 1..N niti na poslovima iz programa (kodiranje BC1 blokova, azuriranje cestica)
+void printJobSystemBenchmark();
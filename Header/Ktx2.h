@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+#include "TextureData.h"
+
+// KTX2 kontejner za teksture pripremljene unaprijed (mip nivoi, blok kompresija, premnozena alfa).
+// Fajl se mapira u memoriju i svaki nivo se salje na graficku karticu direktno, bez dekodovanja.
+
+struct Ktx2Info {
+    int width = 0;
+    int height = 0;
+    int levelCount = 0;
+    GLenum format = 0;
+    bool compressed = false;
+    bool premultipliedAlpha = false; // Za crtanje takve teksture blend treba da bude GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+};
+
+// Vraca 0 ako fajl nije ispravan. Blok kompresovani nivoi se dekoduju na procesoru samo ako ih drajver ne podrzava.
+unsigned loadKtx2Texture(const char* filePath, Ktx2Info* info = nullptr);
+// bakeOptions (ako nije prazno) se upisuje pod kljucem KTX2_BAKE_OPTIONS_KEY, da bi pecenje znalo s kojim je opcijama fajl napravljen
+bool writeKtx2(const char* filePath, const TextureImage& image, bool premultipliedAlpha, const std::string& bakeOptions = std::string());
+bool readKtx2KeyValue(const char* filePath, const char* key, std::string& value);
+
+static const char* const KTX2_BAKE_OPTIONS_KEY = "KosturBakeOptions";
+
+// Komandna linija: --bake-ktx2 <ulazni folder> <izlazni folder> [--format none|auto|bc1|bc3|bc7] [--premultiply] [--no-mips]
+// Pretvara sve PNG/JPEG/BMP/TGA slike iz foldera u .ktx2; preskace slike ciji je .ktx2 noviji od izvora i pecen istim opcijama.
+int runKtx2Baker(int argc, char** argv);
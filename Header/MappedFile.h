@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+
+// Fajl mapiran u memoriju samo za citanje (CreateFileMapping na Windows-u, mmap na ostalim sistemima).
+// Podaci se citaju direktno iz mape, bez kopiranja u bafer.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* filePath);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    bool opened = false;
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+enum class ProgramBuildState { Pending, Ready, Failed };
+
+struct ProgramBuilderStats {
+    unsigned submitted = 0;
+    unsigned fromCache = 0;
+    unsigned ready = 0;
+    unsigned failed = 0;
+    unsigned pollsWaiting = 0; // Koliko puta je poll naisao na program koji drajver jos prevodi
+};
+
+// Pravljenje sejder programa bez blokiranja petlje za crtanje. submit samo preda kod drajveru (glCompileShader +
+// glLinkProgram, bez citanja statusa), a poll, pozvan jednom po frejmu, provjerava GL_COMPLETION_STATUS_KHR i
+// zavrsava programe koje je drajver u medjuvremenu preveo u svojim nitima.
+// Bez GL_KHR/ARB_parallel_shader_compile citanje statusa ceka drajver, pa poll tada zavrsava najvise
+// maxBlockingPerPoll programa po pozivu i tako rasporedi cekanje na vise frejmova.
+// Linkovani programi idu u kes sejdera (ProgramCache) kao i kod createShader; glValidateProgram se ne poziva.
+class ProgramBuilder {
+public:
+    ProgramBuilder();
+    ~ProgramBuilder();
+    ProgramBuilder(const ProgramBuilder&) = delete;
+    ProgramBuilder& operator=(const ProgramBuilder&) = delete;
+
+    // Vraca oznaku programa za isReady / getProgram
+    // Kod fajlova prolazi kroz preprocessShaderFile sa datim definicijama
+    int submit(const char* vsSource, const char* fsSource, const std::string& defines = "");
+    int submitCode(const std::string& name, const std::string& vsCode, const std::string& fsCode, const std::string& defines = "");
+
+    // Zavrsava gotove programe; vraca broj programa zavrsenih u ovom pozivu
+    int poll(int maxBlockingPerPoll = 1);
+    // Ceka sve programe (npr. kraj ekrana za ucitavanje)
+    void finish();
+
+    ProgramBuildState getState(int handle) const;
+    bool isReady(int handle) const { return getState(handle) == ProgramBuildState::Ready; }
+    // 0 dok program nije spreman ili ako nije uspio. Spreman program pripada pozivaocu (builder ga ne brise)
+    unsigned getProgram(int handle) const;
+    int getPendingCount() const { return pendingCount; }
+    bool isParallel() const { return parallel; }
+    const ProgramBuilderStats& getStats() const { return stats; }
+
+private:
+    struct Build {
+        std::string name;
+        unsigned long long cacheKey = 0;
+        double submitTime = 0;
+        GLuint vertexShader = 0;
+        GLuint fragmentShader = 0;
+        GLuint program = 0;
+        ProgramBuildState state = ProgramBuildState::Pending;
+    };
+
+    bool isComplete(const Build& build) const;
+    void complete(Build& build);
+
+    std::vector<Build> builds;
+    int pendingCount = 0;
+    bool parallel = false;
+    ProgramBuilderStats stats;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+// Kes linkovanih sejder programa na disku (glGetProgramBinary / glProgramBinary). Kljuc je hes izvornog koda oba sejdera,
+// ubacenih definicija i GL_VENDOR/GL_RENDERER/GL_VERSION, pa nova verzija drajvera ili izmjena sejdera ponisti unos.
+// Drajver smije da odbije binarni program i kad se kljuc poklapa; tada se unos brise i program se pravi iz izvornog koda.
+
+struct ProgramCacheStats {
+    unsigned hits = 0;
+    unsigned misses = 0;
+    unsigned rejected = 0; // Unosi koje je drajver odbio (ili su osteceni) pa je program ponovo preveden
+    double hitSeconds = 0; // Ukupno vrijeme ucitavanja binarnih programa
+    double missSeconds = 0; // Ukupno vrijeme prevodjenja, linkovanja i upisa u kes
+};
+
+// Prazan string iskljucuje kes; kes ostaje iskljucen i ako drajver ne nudi nijedan binarni format
+void setProgramCacheDirectory(const std::string& directory);
+bool isProgramCacheEnabled();
+
+// name razlikuje programe (npr. putanje sejdera), a key njihov sadrzaj
+unsigned long long programCacheKey(const std::string& vertexCode, const std::string& fragmentCode, const std::string& defines);
+// Vraca linkovan program ili 0 ako unosa nema ili ga je drajver odbio
+unsigned loadCachedProgram(const std::string& name, unsigned long long key);
+// Program mora biti linkovan sa GL_PROGRAM_BINARY_RETRIEVABLE_HINT; buildSeconds je vrijeme prevodjenja za izvjestaj
+void storeCachedProgram(const std::string& name, unsigned long long key, unsigned program, double buildSeconds);
+
+const ProgramCacheStats& getProgramCacheStats();
+void printProgramCacheReport();
@@ -0,0 +1,44 @@
+#pragma once
+
+struct RedrawStats {
+    unsigned long long rendered = 0;
+    unsigned long long wakeups = 0; // Budjenja bez crtanja (npr. pomjeranje misa koje nista ne mijenja)
+    double waitedSeconds = 0; // Vrijeme provedeno blokirano u cekanju dogadjaja
+};
+
+// Crtanje samo kad treba. Frejm se crta ako se nesto vidljivo promijenilo (ulaz, velicina prozora, novi sejder),
+// punom brzinom dok traje interakcija (npr. hrana u vodi), a inace samo ambijentalnom brzinom (spore ribe ne
+// trebaju 60 frejmova u sekundi). Izmedju frejmova nit spava u glfwWaitEventsTimeout umjesto da vrti petlju.
+// Bez on-demand nacina crta se svaki prolaz, a waitForEvents je samo glfwPollEvents.
+class RedrawScheduler {
+public:
+    void init(bool onDemand, double ambientFps);
+    bool isOnDemand() const { return onDemand; }
+
+    void markDirty() { dirty = true; }
+    void setActive(bool isActive) { active = isActive; }
+
+    // Obradjuje dogadjaje; u on-demand nacinu prije toga ceka dogadjaj ili sledeci ambijentalni frejm
+    void waitForEvents(double now);
+    bool shouldRender(double now);
+    void frameRendered(double now);
+
+    const RedrawStats& getStats() const { return stats; }
+    // Iskoriscenost procesora od init, da se uporede on-demand i obican nacin
+    void printReport() const;
+
+private:
+    bool onDemand = false;
+    double ambientInterval = 0.1;
+    double nextAmbientFrame = 0;
+    bool dirty = true;
+    bool active = false;
+    double startWall = 0;
+    double startCpu = 0;
+    RedrawStats stats;
+};
+
+// Procesorsko vrijeme procesa (sve niti), u sekundama
+double processCpuSeconds();
+// Ambijentalna brzina iz komandne linije: "--ambient-fps 10" (podrazumijevano 10)
+double parseAmbientFps(int argc, char** argv);
@@ -0,0 +1,35 @@
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+
+// Framebuffer sa RGBA8 teksturom u koju se crta umjesto u prozor (crtanje bez ekrana, smanjena rezolucija).
+// Tekstura se moze citati u sejderu ili sa glReadPixels.
+class RenderTarget {
+public:
+    RenderTarget() = default;
+    ~RenderTarget();
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    bool create(int width, int height);
+    void destroy();
+    // Vezuje framebuffer za crtanje i postavlja viewport na cijelu teksturu
+    void bind();
+
+    // Piksele cita od donjeg reda (kao OpenGL)
+    bool readPixels(std::vector<unsigned char>& rgba);
+
+    GLuint getFramebuffer() const { return framebuffer; }
+    GLuint getTexture() const { return texture; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    GLuint framebuffer = 0;
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Upisuje RGBA8 piksele (od donjeg reda, kao iz readPixels) u binarni PPM fajl
+bool writePpm(const char* filePath, const unsigned char* rgba, int width, int height);
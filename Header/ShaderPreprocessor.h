@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Priprema GLSL koda prije glShaderSource:
+//  - #include "putanja" (relativno u odnosu na fajl koji ukljucuje) ubacuje sadrzaj fajla; svaki fajl se ubacuje
+//    najvise jednom, pa zajednicki kod ne treba zastitu od visestrukog ukljucivanja
+//  - "defines" (npr. "#define FOG 1\n") se ubacuje odmah iza #version linije
+//  - #line direktive cuvaju brojeve linija, a broj izvora u porukama o gresci je indeks u includedFiles
+// includedFiles dobija sve procitane fajlove (prvi je filePath), za pracenje izmjena.
+// Fajlovi se citaju kroz loadShaderSource, pa dolaze iz ugradjenih sejdera ili sa diska.
+bool preprocessShaderFile(const std::string& filePath, const std::string& defines, std::string& output,
+    std::vector<std::string>* includedFiles = nullptr);
+// Isto za kod koji je vec u memoriji; name je putanja od koje se racunaju #include putanje
+bool preprocessShaderCode(const std::string& name, const std::string& code, const std::string& defines, std::string& output,
+    std::vector<std::string>* includedFiles = nullptr);
+
+// "#define IME 1" za svaki ukljucen bit u features; bit i odgovara featureNames[i]
+std::string featureDefines(unsigned features, const std::vector<std::string>& featureNames);
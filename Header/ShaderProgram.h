@@ -0,0 +1,51 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ShaderVariable {
+    std::string name;
+    GLint location; // -1 za uniforme iz uniform blokova
+    GLenum type; // GL_FLOAT_VEC3, GL_SAMPLER_2D...
+    GLint size; // Broj elemenata niza (1 ako nije niz)
+};
+
+struct ShaderBlock {
+    std::string name;
+    GLuint index;
+    GLint dataSize; // U bajtovima
+    GLint binding;
+};
+
+// Opis sejder programa procitan jednom posle linkovanja: aktivne uniforme, atributi i uniform blokovi sa
+// lokacijama, pa crtanje ne mora da poziva glGetUniformLocation po imenu. Ne posjeduje GL program (ne brise ga).
+// Blok FRAME_UNIFORM_BLOCK se pri citanju vezuje za FRAME_UNIFORM_BINDING (vidi FrameUniforms.h).
+class ShaderProgram {
+public:
+    ShaderProgram() = default;
+    explicit ShaderProgram(unsigned program) { reflect(program); }
+
+    void reflect(unsigned program);
+
+    unsigned getId() const { return id; }
+    GLint getUniformLocation(const std::string& name) const;
+    GLint getAttributeLocation(const std::string& name) const;
+    GLuint getUniformBlockIndex(const std::string& name) const; // GL_INVALID_INDEX ako ga nema
+
+    const std::vector<ShaderVariable>& getUniforms() const { return uniforms; }
+    const std::vector<ShaderVariable>& getAttributes() const { return attributes; }
+    const std::vector<ShaderBlock>& getUniformBlocks() const { return blocks; }
+    void printReflection() const;
+
+private:
+    unsigned id = 0;
+    std::vector<ShaderVariable> uniforms;
+    std::vector<ShaderVariable> attributes;
+    std::vector<ShaderBlock> blocks;
+    std::unordered_map<std::string, GLint> uniformLocations;
+    std::unordered_map<std::string, GLint> attributeLocations;
+};
+
+// createShader koji odmah vraca i opis programa
+ShaderProgram createShaderProgram(const char* vsSource, const char* fsSource, const std::string& defines = "");
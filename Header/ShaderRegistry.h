@@ -0,0 +1,70 @@
+#pragma once
+#include <GL/glew.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FileWatcher.h"
+#include "ProgramBuilder.h"
+#include "ShaderProgram.h"
+
+// Sejder programi sa ponovnim ucitavanjem u toku rada. Programi se prave kroz createShader i drze se pod oznakom,
+// pa kod za crtanje svaki frejm trazi getProgram(oznaka) umjesto da cuva GL ime programa.
+// Kad je ukljuceno pracenje, izmjena .vert/.frag fajla pokrece prevodjenje kroz ProgramBuilder; stari program radi
+// dok novi ne bude gotov, a zamjena (i osvjezavanje kesiranih lokacija uniformi) se desava u update, izmedju frejmova.
+// Ako novi program ima gresku, ostaje stari.
+class ShaderRegistry {
+public:
+    ShaderRegistry() = default;
+    ~ShaderRegistry();
+    ShaderRegistry(const ShaderRegistry&) = delete;
+    ShaderRegistry& operator=(const ShaderRegistry&) = delete;
+
+    // defines se ubacuju iza #version linije (vidi ShaderPreprocessor.h); isti fajlovi sa razlicitim definicijama su
+    // razliciti programi, a za vec dodat program vraca postojecu oznaku
+    int add(const char* vsSource, const char* fsSource, const std::string& defines = "");
+    unsigned getProgram(int handle) const;
+    // Lokacije su iz opisa programa procitanog posle linkovanja; poslije zamjene programa opis se cita ponovo
+    GLint getUniformLocation(int handle, const char* name) const;
+    const ShaderProgram& getReflection(int handle) const;
+
+    // Od ovoga trenutka registar samo cita vise niti (niti crtanja dodatnih prozora), bez zakljucavanja: add bi mogao
+    // da premjesti niz programa ispod njih, pa vise nije dozvoljen, kao ni pracenje fajlova
+    void freeze()
+    {
+        frozen = true;
+        hotReload = false;
+    }
+    bool isFrozen() const { return frozen; }
+
+    void setHotReload(bool enabled);
+    bool isHotReloadEnabled() const { return hotReload; }
+    // Poziva se jednom po frejmu, prije crtanja
+    void update();
+
+    unsigned getReloadCount() const { return reloads; }
+    unsigned getFailedReloadCount() const { return failedReloads; }
+
+private:
+    struct Entry {
+        std::string vsSource;
+        std::string fsSource;
+        std::string defines;
+        std::vector<std::string> files; // Sejderi i svi fajlovi koje ukljucuju, za pracenje izmjena
+        ShaderProgram program;
+        int pendingBuild = -1; // Oznaka u builder-u dok se novi program prevodi
+        bool changedWhileBuilding = false;
+    };
+
+    void watchFiles(Entry& entry);
+    void rebuild(Entry& entry);
+    void swapProgram(Entry& entry, unsigned program);
+
+    std::vector<Entry> entries;
+    std::unique_ptr<ProgramBuilder> builder; // Prave se tek kad se ukljuci pracenje
+    std::unique_ptr<FileWatcher> watcher;
+    bool hotReload = false;
+    bool frozen = false;
+    unsigned reloads = 0;
+    unsigned failedReloads = 0;
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Izvorni kod sejdera u memoriji. Sejderi iz foldera Shaders se pri svakom prevodjenju projekta ugradjuju u program
+// (Tools/EmbedShaders.ps1 pravi Header/EmbeddedShaders.h), sa hesom sadrzaja izracunatim pri prevodjenju.
+struct ShaderSource {
+    const char* path; // "Shaders/overlay.vert", isto kao putanja koja se daje createShader
+    const char* code;
+    size_t size;
+    unsigned long long hash; // hashBytes(code, size)
+};
+
+// nullptr ako sejder sa tom putanjom nije ugradjen
+const ShaderSource* findEmbeddedShader(const std::string& path);
+
+// Kad je ukljuceno, sejderi se citaju sa diska (razvoj, ponovno ucitavanje u toku rada), a ugradjeni kod se koristi
+// samo za fajlove kojih nema. Podrazumijevano iskljuceno: program ne zavisi od radnog foldera.
+void setShaderDiskOverride(bool enabled);
+bool isShaderDiskOverrideEnabled();
+
+// Kod sejdera sa date putanje, iz ugradjenih sejdera ili sa diska (vidi setShaderDiskOverride)
+bool loadShaderSource(const std::string& path, std::string& code);
@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ShaderRegistry.h"
+
+// Varijante jednog para sejdera po kombinaciji osobina (npr. osvjetljenje, tekstura/paleta, magla). Umjesto jednog
+// sejdera sa if-ovima u toku rada, svaka kombinacija se prevodi posebno sa "#define OSOBINA 1", pa drajver izbaci
+// nekoristene grane. Varijanta se pravi pri prvom trazenju i pamti pod maskom osobina; programi su u ShaderRegistry,
+// pa se i varijante ponovo ucitavaju kad se fajl izmijeni.
+//
+//   ShaderVariants fish(shaders, "Shaders/fish.vert", "Shaders/fish.frag", { "LIT", "TEXTURED", "FOG" });
+//   glState().useProgram(fish.getProgram(LIT | FOG));
+class ShaderVariants {
+public:
+    ShaderVariants(ShaderRegistry& shaders, const char* vsSource, const char* fsSource, const std::vector<std::string>& featureNames);
+
+    // Oznaka u ShaderRegistry za datu kombinaciju (bit i ukljucuje featureNames[i])
+    int getHandle(unsigned features);
+    unsigned getProgram(unsigned features) { return shaders.getProgram(getHandle(features)); }
+    size_t getVariantCount() const { return variants.size(); }
+
+private:
+    ShaderRegistry& shaders;
+    std::string vsSource;
+    std::string fsSource;
+    std::vector<std::string> featureNames;
+    std::unordered_map<unsigned, int> variants;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Aquarium.h"
+#include "FrameScheduler.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+// Nepromjenljiv snimak simulacije za crtanje: poslednja dva stanja riba (za interpolaciju) i hrana
+struct AquariumSnapshot {
+    std::vector<FishState> previous;
+    std::vector<FishState> current;
+    std::vector<FoodState> food;
+    unsigned long long tick = 0;
+    float alpha = 0; // Ostatak akumulatora u trenutku objavljivanja, u koracima
+    double time = 0; // simulationClock() u trenutku objavljivanja
+};
+
+struct SimulationThreadStats {
+    unsigned long long ticks = 0;
+    unsigned long long snapshots = 0;
+    unsigned long long droppedInputs = 0; // Dogadjaji koji nisu stali u red
+};
+
+// Simulacija akvarijuma u posebnoj niti, fiksnim korakom (FrameScheduler). Poslije svakog izvrsenog koraka
+// objavljuje snimak kroz TripleBuffer; nit crtanja uvijek uzima najnoviji kompletan snimak, bez cekanja.
+// Dogadjaji sa ulaza idu u suprotnom smjeru kroz SpscQueue i primjenjuju se na pocetku sledeceg koraka.
+// U nacinu na zahtjev (setOnDemand) nit ne otkucava sama, nego spava dok crtanje ne zatrazi snimak (requestSnapshot).
+// Sve funkcije osim run se pozivaju iz jedne (glavne) niti.
+class SimulationThread {
+public:
+    SimulationThread() = default;
+    ~SimulationThread();
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // recorder (ako nije nullptr) dobija sve dogadjaje koje simulacija primijeni, iz niti simulacije
+    bool start(int fishCount, unsigned seed, double tickRate, InputRecorder* recorder = nullptr);
+    void stop();
+    // Stanje simulacije; smije se citati samo kad nit ne radi (poslije stop)
+    const Aquarium& getAquarium() const { return aquarium; }
+
+    // Crtanje na zahtjev: nit simulacije spava izmedju frejmova umjesto da radi punim korakom
+    void setOnDemand(bool enabled);
+    // Na zahtjev: budi nit simulacije, koja stigne do tekuceg vremena i objavi snimak, i ceka da ga objavi
+    void requestSnapshot();
+
+    // false ako je red pun
+    bool pushInput(const AquariumInput& input);
+    // Najnoviji objavljeni snimak; updated (ako nije nullptr) kaze da li je stigao novi od prethodnog poziva
+    const AquariumSnapshot& acquireSnapshot(bool* updated = nullptr);
+    // Udio izmedju previous i current za dati snimak u ovom trenutku, [0, 1]
+    float getAlpha(const AquariumSnapshot& snapshot) const;
+
+    SimulationThreadStats getStats() const;
+
+private:
+    void run();
+
+    Aquarium aquarium;
+    FrameScheduler scheduler; // Koristi ga samo nit simulacije
+    double tickSeconds = 0;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::atomic<bool> onDemand{ false };
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition; // Zahtjev za snimkom (ka simulaciji) i objavljen snimak (ka crtanju)
+    unsigned long long requested = 0; // Zasticeno sa wakeMutex
+    unsigned long long served = 0; // Zasticeno sa wakeMutex
+    TripleBuffer<AquariumSnapshot> snapshots;
+    SpscQueue<AquariumInput, 256> inputs;
+    std::atomic<unsigned long long> ticks{ 0 };
+    std::atomic<unsigned long long> published{ 0 };
+    unsigned long long droppedInputs = 0;
+};
+
+// Monotono vrijeme u sekundama, zajednicko za nit simulacije i nit crtanja
+double simulationClock();
@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Red fiksne velicine bez zakljucavanja za tacno jednu nit koja dodaje i jednu koja uzima
+// (npr. dogadjaji sa ulaza iz glavne niti ka niti simulacije). Capacity mora biti stepen dvojke.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity mora biti stepen dvojke");
+
+public:
+    // false ako je red pun (dogadjaj se ne dodaje)
+    bool push(const T& item)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // false ako je red prazan
+    bool pop(T& item)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[Capacity];
+    //Odvojene linije kesa, da niti ne dijele liniju koju obje mijenjaju
+    alignas(64) std::atomic<size_t> head{ 0 };
+    alignas(64) std::atomic<size_t> tail{ 0 };
+};
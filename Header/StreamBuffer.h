@@ -0,0 +1,53 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <vector>
+
+struct StreamBufferStats {
+    unsigned long long frames = 0;
+    unsigned long long waits = 0; // Koliko puta je GPU kasnio vise od (particija - 1) frejmova pa se cekao fence
+    unsigned long long overflows = 0; // Koliko zahtjeva nije stalo u particiju (bafer se nikad ne povecava)
+    size_t peakBytes = 0; // Najvise zauzeto u jednoj particiji
+};
+
+// Prstenasti bafer za podatke koji se mijenjaju svaki frejm (pozicije riba, mjehurica, hrane...).
+// Bafer fiksne velicine je podijeljen na particije (podrazumijevano 3); CPU pise u jednu dok GPU cita prethodne,
+// a glFenceSync na kraju frejma cuva particiju dok je GPU ne procita.
+// Sa GL_ARB_buffer_storage bafer je trajno mapiran; na cistom 3.3 kontekstu svaki upis se mapira sa
+// GL_MAP_UNSYNCHRONIZED_BIT, jer fence vec garantuje da GPU ne koristi taj dio bafera.
+class StreamBuffer {
+public:
+    StreamBuffer() = default;
+    ~StreamBuffer();
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    bool create(GLenum target, size_t partitionSize, int partitionCount = 3);
+    void destroy();
+
+    // Prelazi na sledecu particiju
+    void beginFrame();
+    // Rezervise "size" bajtova u tekucoj particiji i vraca pokazivac za upis (nullptr ako nema mjesta).
+    // offset je pozicija u baferu za glVertexAttribPointer / glDrawArrays. Prije crtanja pozvati unmap().
+    void* map(size_t size, size_t alignment, size_t& offset);
+    void unmap();
+    // Poziva se poslije svih crtanja koja citaju iz tekuce particije
+    void endFrame();
+
+    GLuint getBuffer() const { return buffer; }
+    GLenum getTarget() const { return target; }
+    bool isPersistent() const { return persistent; }
+    const StreamBufferStats& getStats() const { return stats; }
+
+private:
+    GLenum target = GL_ARRAY_BUFFER;
+    GLuint buffer = 0;
+    bool persistent = false;
+    bool mapped = false;
+    unsigned char* persistentData = nullptr;
+    size_t partitionSize = 0;
+    int partition = 0;
+    size_t used = 0; // Zauzeto u tekucoj particiji
+    std::vector<GLsync> fences;
+    StreamBufferStats stats;
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+
+#include "TextureData.h"
+
+// Kes dekodovanih tekstura na disku. Svaki unos cuva gotov lanac mip nivoa sa malim zaglavljem, a kljuc je hes
+// sadrzaja izvornog fajla i opcija ucitavanja, pa se unos sam ponisti cim se izvorna slika promijeni.
+// Pri sledecem pokretanju unos se mapira u memoriju i salje direktno na graficku karticu, bez dekodovanja.
+
+struct TextureCacheStats {
+    unsigned hits = 0;
+    unsigned misses = 0;
+    double hitSeconds = 0; // Ukupno vrijeme ucitavanja iz kesa (toplo pokretanje)
+    double missSeconds = 0; // Ukupno vrijeme dekodovanja i upisa u kes (hladno pokretanje)
+};
+
+// Prazan string iskljucuje kes
+void setTextureCacheDirectory(const std::string& directory);
+bool isTextureCacheEnabled();
+
+// Koristi ga loadImageToTexture kad je kes ukljucen
+unsigned loadTextureThroughCache(const char* filePath, const TextureLoadOptions& options);
+
+const TextureCacheStats& getTextureCacheStats();
+void printTextureCacheReport();
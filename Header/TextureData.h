@@ -0,0 +1,54 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <vector>
+
+// Blok kompresija tekstura na procesoru prije slanja na graficku karticu
+enum class TextureCompression {
+    None,
+    Auto, // BC1 za slike bez alfa kanala, BC7 (ili BC3 ako BC7 nije podrzan) za slike sa alfa kanalom
+    BC1,
+    BC3,
+    BC7,
+};
+
+// Opcije ucitavanja teksture (ulaze i u kljuc kesa tekstura)
+struct TextureLoadOptions {
+    bool flipVertically = true; // Slike se osnovno ucitavaju naopako pa se ispravljaju
+    bool generateMipmaps = false; // Pravi cijeli lanac mip nivoa na procesoru
+    TextureCompression compression = TextureCompression::None; // Ako drajver ne podrzava format, ostaje nekompresovana
+};
+
+// Jedan mip nivo unutar bafera sa pikselima
+struct TextureLevel {
+    int width = 0;
+    int height = 0;
+    size_t offset = 0; // Pomjeraj od pocetka bafera
+    size_t size = 0; // Velicina nivoa u bajtovima
+};
+
+// Slika spremna za slanje na graficku karticu: svi mip nivoi su jedan za drugim u jednom baferu
+struct TextureImage {
+    GLenum format = GL_RGBA; // GL_RED/GL_RG/GL_RGB/GL_RGBA ili kompresovani interni format
+    bool compressed = false;
+    std::vector<TextureLevel> levels;
+    std::vector<unsigned char> pixels;
+};
+
+GLenum textureFormatForChannels(int channels);
+int textureChannelsForFormat(GLenum format);
+
+// Racuna dimenzije i pomjeraje svih nivoa za nekompresovanu sliku (redovi nisu poravnati, UNPACK_ALIGNMENT = 1)
+void layoutTextureLevels(int width, int height, int channels, bool mipmaps, std::vector<TextureLevel>& levels);
+// Dekoduje PNG/JPEG/... iz memorije pomocu stb_image i po potrebi pravi mip nivoe i kompresuje ih
+bool decodeImage(const unsigned char* fileData, size_t fileSize, const TextureLoadOptions& options, TextureImage& image);
+bool decodeImageFile(const char* filePath, const TextureLoadOptions& options, TextureImage& image);
+// Od nekompresovane slike sa jednim nivoom pravi cijeli lanac mip nivoa (prosjek 2x2 piksela)
+void generateTextureMipmaps(TextureImage& image);
+
+// Pravi OpenGL teksturu od vec pripremljenih nivoa, bez ikakve obrade na procesoru. Vraca 0 ako ne uspije.
+unsigned uploadTexture(GLenum format, bool compressed, const TextureLevel* levels, size_t levelCount, const unsigned char* data);
+inline unsigned uploadTexture(const TextureImage& image)
+{
+    return uploadTexture(image.format, image.compressed, image.levels.data(), image.levels.size(), image.pixels.data());
+}
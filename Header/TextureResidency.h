@@ -0,0 +1,72 @@
+#pragma once
+#include <GL/glew.h>
+#include <list>
+#include <string>
+#include <vector>
+
+// Statistika menadzera rezidentnosti tekstura
+struct TextureResidencyStats {
+    size_t residentBytes = 0; // Koliko bajtova tekstura je trenutno na grafickoj kartici
+    size_t budgetBytes = 0; // Dozvoljeni budzet
+    unsigned residentCount = 0; // Broj tekstura koje su trenutno ucitane
+    unsigned long long evictions = 0; // Koliko puta je neka tekstura izbacena iz memorije
+    unsigned long long refaults = 0; // Koliko puta je izbacena tekstura morala ponovo da se ucita
+};
+
+// Parametri koji se postavljaju teksturi svaki put kad se (ponovo) ucita
+struct TextureParams {
+    GLint minFilter = GL_LINEAR;
+    GLint magFilter = GL_LINEAR;
+    GLint wrapS = GL_CLAMP_TO_EDGE;
+    GLint wrapT = GL_CLAMP_TO_EDGE;
+};
+
+// Menadzer rezidentnosti: prati velicinu svake teksture u video memoriji i frejm kad je posljednji put koristena.
+// Kad se predje budzet, izbacuje najdavnije koristene teksture (LRU), a izbacene se ponovo ucitavaju sa diska
+// preko loadImageToTexture cim zatrebaju.
+class TextureResidency {
+public:
+    explicit TextureResidency(size_t budgetBytes);
+    ~TextureResidency();
+
+    // Registruje teksturu i vraca rucku (handle) preko koje se kasnije koristi. Ucitava se tek pri prvom use().
+    unsigned add(const char* filePath, const TextureParams& params = TextureParams());
+    // Vraca OpenGL id teksture za crtanje u ovom frejmu, po potrebi je ponovo ucitava (0 ako ucitavanje ne uspije)
+    unsigned use(unsigned handle);
+    // Poziva se jednom na pocetku svakog frejma
+    void beginFrame();
+    void setBudget(size_t budgetBytes);
+    // Zakucana tekstura se nikad ne izbacuje (npr. kad je id predat nitima drugih prozora koje ne prolaze kroz use())
+    void setPinned(unsigned handle, bool pinned);
+    // Izbacuje sve teksture iz video memorije (registracije ostaju)
+    void evictAll();
+
+    const TextureResidencyStats& getStats() const { return stats; }
+    unsigned long long getFrame() const { return frame; }
+    void printReport() const;
+
+private:
+    struct Entry {
+        std::string path;
+        TextureParams params;
+        unsigned texture = 0; // 0 ako tekstura nije rezidentna
+        size_t bytes = 0;
+        unsigned long long lastUsedFrame = 0;
+        bool everLoaded = false;
+        bool pinned = false;
+        std::list<unsigned>::iterator lruIt; // Pozicija u LRU listi (validna samo dok je rezidentna)
+    };
+
+    void evict(Entry& entry);
+    void enforceBudget();
+
+    std::vector<Entry> entries;
+    std::list<unsigned> lru; // Rucke rezidentnih tekstura, na pocetku je najskorije koristena
+    unsigned long long frame = 1;
+    TextureResidencyStats stats;
+};
+
+// Racuna koliko bajtova zauzima tekstura (svi mip nivoi) na osnovu onoga sto drajver prijavi
+size_t textureByteSize(unsigned texture);
+// Budzet iz komandne linije: --texture-budget <MB> (podrazumijevano 256 MB)
+size_t parseTextureBudget(int argc, char** argv);
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+
+// Trostruki bafer bez zakljucavanja za jednog pisca i jednog citaoca (npr. nit simulacije -> nit crtanja).
+// Pisac puni svoj bafer i objavljuje ga zamjenom sa srednjim; citalac uzima srednji samo ako je u njemu nesto novo.
+// Nijedna strana nikad ne ceka: pisac moze da objavi vise puta prije nego sto citalac pogleda (stariji
+// snimci se preskacu), a citalac do sledeceg objavljivanja cita isti, kompletan snimak.
+// Baferi se ponovo koriste, pa std::vector u T poslije prvih nekoliko frejmova ne alocira memoriju.
+template <typename T>
+class TripleBuffer {
+public:
+    // Pisac: bafer u koji se pise sledeci snimak
+    T& getWriteBuffer() { return buffers[writeIndex]; }
+    void publish()
+    {
+        //release: citalac koji vidi novi indeks vidi i sve upisano u bafer
+        unsigned char old = middle.exchange((unsigned char)(writeIndex | NEW_DATA), std::memory_order_acq_rel);
+        writeIndex = old & INDEX_MASK;
+    }
+
+    // Citalac: prelazi na najnoviji objavljeni snimak; false ako novog nema (ostaje prethodni)
+    bool acquire()
+    {
+        if ((middle.load(std::memory_order_relaxed) & NEW_DATA) == 0) return false;
+        unsigned char old = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = old & INDEX_MASK;
+        return true;
+    }
+    const T& getReadBuffer() const { return buffers[readIndex]; }
+
+private:
+    static const unsigned char INDEX_MASK = 3;
+    static const unsigned char NEW_DATA = 4;
+
+    T buffers[3];
+    unsigned char writeIndex = 0; // Koristi samo pisac
+    unsigned char readIndex = 2; // Koristi samo citalac
+    std::atomic<unsigned char> middle{ 1 };
+};
@@ -2,7 +2,13 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <string>
+#include "ShaderSources.h"
+#include "TextureData.h"
 int endProgram(std::string message);
+std::string readShaderFile(const char* source);
 unsigned int createShader(const char* vsSource, const char* fsSource);
+unsigned int createShader(const char* vsSource, const char* fsSource, const std::string& defines);
+unsigned int createShader(const ShaderSource& vsSource, const ShaderSource& fsSource, const std::string& defines = "");
 unsigned loadImageToTexture(const char* filePath);
+unsigned loadImageToTexture(const char* filePath, const TextureLoadOptions& options);
 GLFWcursor* loadImageToCursor(const char* filePath);
\ No newline at end of file
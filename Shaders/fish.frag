@@ -0,0 +1,22 @@
+#version 330 core
+#include "frame.glsl"
+
+in vec4 chCol;
+out vec4 outCol;
+
+#ifdef TEXTURED
+uniform sampler2D uTexture;
+in vec2 chUv;
+#endif
+
+void main()
+{
+    vec4 color = chCol;
+#ifdef TEXTURED
+    //Tekstura daje sare, a boja ribe je i dalje boji
+    color *= texture(uTexture, chUv);
+#endif
+    //Dublje ribe su malo vise u boji vode
+    float depth = clamp((uWaterLevel - gl_FragCoord.y / uResolution.y * 2.0 + 1.0) * 0.25, 0.0, 0.5);
+    outCol = vec4(mix(color.rgb, uWaterColor.rgb, depth), color.a);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+#include "frame.glsl"
+
+layout(location = 0) in vec2 inPos;
+layout(location = 1) in vec4 inCol;
+out vec4 chCol;
+
+#ifdef TEXTURED
+layout(location = 2) in vec2 inUv;
+out vec2 chUv;
+#endif
+
+void main()
+{
+    gl_Position = uViewProjection * vec4(inPos, 0.0, 1.0);
+    chCol = inCol;
+#ifdef TEXTURED
+    chUv = inUv;
+#endif
+}
@@ -0,0 +1,13 @@
+// Podaci frejma zajednicki za sve programe (FrameUniforms.h, vezivanje 0). Ukljucuje se sa #include "frame.glsl"
+layout(std140) uniform FrameData
+{
+    mat4 uViewProjection;
+    float uTime;
+    float uDeltaTime;
+    vec2 uResolution;
+    vec4 uWaterColor;
+    float uWaterLevel;
+    float uWaveAmplitude;
+    float uWaveFrequency;
+    float uWaveSpeed;
+};
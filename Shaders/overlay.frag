@@ -0,0 +1,9 @@
+#version 330 core
+
+in vec4 chCol;
+out vec4 outCol;
+
+void main()
+{
+    outCol = chCol;
+}
@@ -0,0 +1,32 @@
+#version 330 core
+
+uniform sampler2D uSource;
+uniform vec2 uUvScale;
+uniform float uSharpness; // 0 = samo bilinearno
+in vec2 chUv;
+out vec4 outCol;
+
+vec3 sampleArea(vec2 uv, vec2 texel)
+{
+    //Van dijela u koji je crtano su ostaci vecih frejmova, pa se uzorci drze pola teksela unutra
+    return texture(uSource, clamp(uv, texel * 0.5, uUvScale - texel * 0.5)).rgb;
+}
+
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(uSource, 0));
+    vec3 color = sampleArea(chUv, texel);
+    if (uSharpness > 0.0)
+    {
+        //Izostravanje: razlika od susjednih teksela, ograniceno njihovim opsegom da ne nastanu oreoli oko ivica
+        vec3 north = sampleArea(chUv + vec2(0.0, texel.y), texel);
+        vec3 south = sampleArea(chUv - vec2(0.0, texel.y), texel);
+        vec3 east = sampleArea(chUv + vec2(texel.x, 0.0), texel);
+        vec3 west = sampleArea(chUv - vec2(texel.x, 0.0), texel);
+        vec3 low = min(min(north, south), min(east, west));
+        vec3 high = max(max(north, south), max(east, west));
+        vec3 sharpened = color + (4.0 * color - north - south - east - west) * uSharpness * 0.25;
+        color = clamp(sharpened, min(low, color), max(high, color));
+    }
+    outCol = vec4(color, 1.0);
+}
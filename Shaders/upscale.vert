@@ -0,0 +1,12 @@
+#version 330 core
+
+uniform vec2 uUvScale; // Dio teksture u koji je crtano (velicina crtanja kroz velicinu teksture)
+out vec2 chUv;
+
+void main()
+{
+    //Jedan trougao preko cijelog ekrana, bez bafera temena
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    chUv = corner * uUvScale;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
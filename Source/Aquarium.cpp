@@ -0,0 +1,270 @@
+#include "../Header/Aquarium.h"
+#include "../Header/InputLog.h"
+
+#include <cmath>
+
+// Opis: simulacija riba u akvarijumu (lutanje, jato, odbijanje od zidova, mahanje repom) kao sistemi nad komponentama entiteta
+
+static const float PI = 3.14159265358979f;
+static const int FOOD_TICKS = 60 * 20;
+static const float FOOD_SINK_SPEED = 0.05f;
+static const float FOOD_SIGHT = 0.4f; // Riba primijeti hranu na ovoj udaljenosti
+static const float FOOD_EAT_DISTANCE = 0.02f;
+static const float CURSOR_FEAR = 0.15f; // Riba bjezi od kursora blizeg od ovoga
+static const float SCHOOL_TURN = 1.5f; // Najbrze okretanje ka jatu, radijana u sekundi
+
+float Aquarium::random()
+{
+    //xorshift32: brz, a isto seme uvijek daje isti niz na svim platformama
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState >> 8) * (1.0f / 16777216.0f);
+}
+
+Aquarium::Aquarium()
+{
+    entities.registerPool(positions);
+    entities.registerPool(motions);
+    entities.registerPool(animations);
+    entities.registerPool(appearances);
+    entities.registerPool(foods);
+}
+
+void Aquarium::init(int fishCount, unsigned newSeed, const TankBounds& tankBounds)
+{
+    seed = newSeed;
+    randomState = newSeed != 0 ? newSeed : 1;
+    bounds = tankBounds;
+    tick = 0;
+    foodSequence = 0;
+    cursorX = AQUARIUM_CURSOR_AWAY;
+    cursorY = AQUARIUM_CURSOR_AWAY;
+    entities.clear();
+    positions.clear();
+    motions.clear();
+    animations.clear();
+    appearances.clear();
+    foods.clear();
+
+    int count = fishCount > 0 ? fishCount : 0;
+    positions.reserve(count + AQUARIUM_MAX_FOOD);
+    motions.reserve(count);
+    animations.reserve(count);
+    appearances.reserve(count);
+    foods.reserve(AQUARIUM_MAX_FOOD);
+    food.reserve(AQUARIUM_MAX_FOOD);
+    for (int i = 0; i < count; i++)
+    {
+        Entity fish = entities.create();
+        Position& position = positions.add(fish);
+        position.x = bounds.left + random() * (bounds.right - bounds.left);
+        position.y = bounds.bottom + random() * (bounds.top - bounds.bottom);
+        Motion& motion = motions.add(fish);
+        motion.heading = random() * 2.0f * PI;
+        motion.speed = 0.1f + random() * 0.15f;
+        animations.add(fish).phase = random() * 2.0f * PI;
+        Appearance& appearance = appearances.add(fish);
+        appearance.size = 0.6f + random() * 0.8f;
+        appearance.color[0] = 0.9f + random() * 0.1f;
+        appearance.color[1] = 0.3f + random() * 0.5f;
+        appearance.color[2] = random() * 0.3f;
+    }
+    exportState();
+    previous = current;
+}
+
+void Aquarium::apply(const AquariumInput& input)
+{
+    if (recorder != nullptr) recorder->record(tick, input);
+    if (input.type == AquariumInput::Cursor)
+    {
+        cursorX = input.x;
+        cursorY = input.y;
+    }
+    else if (input.type == AquariumInput::Key)
+    {
+        if (input.key == AQUARIUM_KEY_SCATTER && input.action == 1) //GLFW_PRESS
+        {
+            forEach(motions, [&](Entity, Motion& motion) { motion.heading = random() * 2.0f * PI; });
+            exportState();
+        }
+    }
+    else if (input.type == AquariumInput::Feed)
+    {
+        if ((int)foods.size() >= AQUARIUM_MAX_FOOD)
+        {
+            //Najstarija hrana nestaje
+            Entity oldest;
+            unsigned long long oldestSequence = ~0ull;
+            forEach(foods, [&](Entity pellet, Food& item) {
+                if (item.sequence < oldestSequence)
+                {
+                    oldest = pellet;
+                    oldestSequence = item.sequence;
+                }
+            });
+            entities.destroy(oldest);
+        }
+        Entity pellet = entities.create();
+        Position& position = positions.add(pellet);
+        position.x = std::fmin(std::fmax(input.x, bounds.left), bounds.right);
+        position.y = std::fmin(std::fmax(input.y, bounds.bottom), bounds.top);
+        Food& item = foods.add(pellet);
+        item.ticksLeft = FOOD_TICKS;
+        item.sequence = foodSequence++;
+        exportState();
+    }
+}
+
+void Aquarium::step(float dt)
+{
+    previous = current;
+    tick++;
+
+    //Hrana tone i istice; entiteti se brisu tek poslije prolaza kroz nizove
+    expired.clear();
+    forEach(foods, positions, [&](Entity pellet, Food& item, Position& position) {
+        position.y = std::fmax(position.y - FOOD_SINK_SPEED * dt, bounds.bottom);
+        if (--item.ticksLeft <= 0) expired.push_back(pellet);
+    });
+    for (Entity pellet : expired) entities.destroy(pellet);
+    expired.clear();
+
+    //Jato se racuna iz stanja na pocetku koraka, pa redosljed riba ne utice na rezultat
+    school.resize(motions.size());
+    size_t count = 0;
+    forEach(motions, positions, [&](Entity, Motion& motion, Position& fish) {
+        school.x[count] = fish.x;
+        school.y[count] = fish.y;
+        school.dirX[count] = std::cos(motion.heading);
+        school.dirY[count] = std::sin(motion.heading);
+        count++;
+    });
+    school.resize(count);
+    boids.update(school, bounds.left, bounds.bottom, bounds.right, bounds.top, schooling);
+
+    size_t i = 0;
+    forEach(motions, positions, animations, [&](Entity, Motion& motion, Position& fish, Animation& animation) {
+        float steerX = boids.getSteerX()[i], steerY = boids.getSteerY()[i];
+        i++;
+        //Riba polako skrece nasumicno, a rep mase brze sto brze pliva
+        motion.heading += (random() - 0.5f) * 2.0f * dt;
+        Food* nearest = nullptr;
+        Entity nearestPellet;
+        Position nearestPosition = {};
+        float nearestDistance = FOOD_SIGHT * FOOD_SIGHT;
+        forEach(foods, positions, [&](Entity pellet, Food& item, Position& position) {
+            if (item.ticksLeft <= 0) return; //Vec pojedena u ovom koraku
+            float dx = position.x - fish.x, dy = position.y - fish.y;
+            float distance = dx * dx + dy * dy;
+            if (distance < nearestDistance)
+            {
+                nearest = &item;
+                nearestPellet = pellet;
+                nearestPosition = position;
+                nearestDistance = distance;
+            }
+        });
+        float cursorDx = fish.x - cursorX, cursorDy = fish.y - cursorY;
+        if (cursorDx * cursorDx + cursorDy * cursorDy < CURSOR_FEAR * CURSOR_FEAR)
+        {
+            //Strah je jaci od gladi: riba se okrece od kursora
+            float target = std::atan2(cursorDy, cursorDx);
+            float difference = std::remainder(target - motion.heading, 2.0f * PI);
+            motion.heading += std::fmax(-4.0f * dt, std::fmin(4.0f * dt, difference));
+        }
+        else if (nearest != nullptr)
+        {
+            //Okrece se ka hrani, a kad stigne do nje pojede je
+            if (nearestDistance < FOOD_EAT_DISTANCE * FOOD_EAT_DISTANCE)
+            {
+                nearest->ticksLeft = 0;
+                expired.push_back(nearestPellet);
+            }
+            else
+            {
+                float target = std::atan2(nearestPosition.y - fish.y, nearestPosition.x - fish.x);
+                float difference = std::remainder(target - motion.heading, 2.0f * PI);
+                motion.heading += std::fmax(-3.0f * dt, std::fmin(3.0f * dt, difference));
+            }
+        }
+        else if (steerX != 0.0f || steerY != 0.0f)
+        {
+            //Inace se drzi jata
+            float target = std::atan2(steerY, steerX);
+            float difference = std::remainder(target - motion.heading, 2.0f * PI);
+            motion.heading += std::fmax(-SCHOOL_TURN * dt, std::fmin(SCHOOL_TURN * dt, difference));
+        }
+        animation.phase += dt * (6.0f + motion.speed * 30.0f);
+        if (animation.phase > 2.0f * PI) animation.phase -= 2.0f * PI;
+
+        fish.x += std::cos(motion.heading) * motion.speed * dt;
+        fish.y += std::sin(motion.heading) * motion.speed * dt;
+
+        //Odbijanje od zidova akvarijuma
+        if (fish.x < bounds.left || fish.x > bounds.right)
+        {
+            motion.heading = PI - motion.heading;
+            fish.x = fish.x < bounds.left ? bounds.left : bounds.right;
+        }
+        if (fish.y < bounds.bottom || fish.y > bounds.top)
+        {
+            motion.heading = -motion.heading;
+            fish.y = fish.y < bounds.bottom ? bounds.bottom : bounds.top;
+        }
+    });
+    for (Entity pellet : expired) entities.destroy(pellet);
+    exportState();
+}
+
+void Aquarium::exportState()
+{
+    //Ribe redom kojim su napravljene (gust niz kretanja), hrana redom gustog niza
+    current.resize(motions.size());
+    size_t i = 0;
+    forEach(motions, positions, animations, [&](Entity entity, Motion& motion, Position& position, Animation& animation) {
+        const Appearance* appearance = findAligned(appearances, i, entity);
+        FishState& fish = current[i++];
+        fish.x = position.x;
+        fish.y = position.y;
+        fish.heading = motion.heading;
+        fish.speed = motion.speed;
+        fish.phase = animation.phase;
+        fish.size = appearance->size;
+        fish.color[0] = appearance->color[0];
+        fish.color[1] = appearance->color[1];
+        fish.color[2] = appearance->color[2];
+    });
+    current.resize(i);
+
+    food.clear();
+    forEach(foods, positions, [&](Entity, Food& item, Position& position) {
+        food.push_back({ position.x, position.y, item.ticksLeft });
+    });
+}
+
+static float lerpAngle(float from, float to, float alpha)
+{
+    //Najkraci put izmedju dva ugla, da riba ne napravi pun krug pri prelasku preko 0
+    float difference = std::fmod(to - from, 2.0f * PI);
+    if (difference > PI) difference -= 2.0f * PI;
+    if (difference < -PI) difference += 2.0f * PI;
+    return from + difference * alpha;
+}
+
+void interpolateFish(const std::vector<FishState>& previous, const std::vector<FishState>& current, float alpha,
+    std::vector<FishState>& out)
+{
+    out.resize(current.size());
+    for (size_t i = 0; i < current.size(); i++)
+    {
+        const FishState& a = i < previous.size() ? previous[i] : current[i];
+        const FishState& b = current[i];
+        out[i] = b;
+        out[i].x = a.x + (b.x - a.x) * alpha;
+        out[i].y = a.y + (b.y - a.y) * alpha;
+        out[i].heading = lerpAngle(a.heading, b.heading, alpha);
+        out[i].phase = lerpAngle(a.phase, b.phase, alpha);
+    }
+}
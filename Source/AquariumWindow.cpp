@@ -0,0 +1,187 @@
+#include "../Header/AquariumWindow.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Opis: dodatni prozor akvarijuma sa dijeljenim kontekstom, svojom simulacijom i svojom niti crtanja
+
+AquariumWindow::~AquariumWindow()
+{
+    stop();
+}
+
+void AquariumWindow::framebufferSizeCallback(GLFWwindow* window, int width, int height)
+{
+    AquariumWindow* self = (AquariumWindow*)glfwGetWindowUserPointer(window);
+    self->framebufferWidth.store(width);
+    self->framebufferHeight.store(height);
+}
+
+bool AquariumWindow::create(GLFWwindow* primary, ShaderRegistry& shaders, int windowIndex, int fishCount, unsigned seed,
+    double tickRate, const FrameUniformData& data)
+{
+    index = windowIndex;
+    frameData = data;
+    std::string title = "Kostur " + std::to_string(index + 1);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    window = glfwCreateWindow(800, 800, title.c_str(), NULL, primary);
+    if (window == NULL)
+    {
+        std::cout << "Prozor " << index + 1 << " nije uspeo da se kreira" << std::endl;
+        return false;
+    }
+
+    //Svaki akvarijum na svoj monitor, dok ih ima; ostali se slazu jedan preko drugog
+    int monitorCount = 0;
+    GLFWmonitor** monitors = glfwGetMonitors(&monitorCount);
+    int x = 100 + 40 * index, y = 100 + 40 * index;
+    if (monitors != nullptr && index < monitorCount)
+    {
+        glfwGetMonitorPos(monitors[index], &x, &y);
+        x += 100;
+        y += 100;
+    }
+    glfwSetWindowPos(window, x, y);
+    glfwSetWindowUserPointer(window, this);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    framebufferWidth.store(width);
+    framebufferHeight.store(height);
+
+    //GL objekti prozora se prave u njegovom kontekstu, sa njegovim kesom stanja
+    GLFWwindow* previousContext = glfwGetCurrentContext();
+    GLStateCache* previousState = &glState();
+    glfwMakeContextCurrent(window);
+    setCurrentGLState(&state);
+    glState().setEnabled(GL_BLEND, true);
+    glState().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glClearColor(frameData.waterColor[0], frameData.waterColor[1], frameData.waterColor[2], frameData.waterColor[3]);
+    bool created = frameUniforms.create() && fishRenderer.create(shaders, fishCount);
+    glfwMakeContextCurrent(previousContext);
+    setCurrentGLState(previousState);
+    if (!created)
+    {
+        //Ono sto jeste napravljeno brise stop, u kontekstu prozora
+        std::cout << "GL objekti prozora " << index + 1 << " nisu napravljeni" << std::endl;
+        return false;
+    }
+
+    simulation.start(fishCount, seed, tickRate);
+    return true;
+}
+
+void AquariumWindow::start()
+{
+    if (window == nullptr || thread.joinable()) return;
+    running.store(true);
+    thread = std::thread(&AquariumWindow::renderLoop, this);
+}
+
+void AquariumWindow::stop()
+{
+    running.store(false);
+    if (thread.joinable()) thread.join();
+    else if (window != nullptr)
+    {
+        //Nit nije pokrenuta, pa se objekti prozora brisu ovdje, u njegovom kontekstu
+        GLFWwindow* previousContext = glfwGetCurrentContext();
+        GLStateCache* previousState = &glState();
+        glfwMakeContextCurrent(window);
+        setCurrentGLState(&state);
+        fishRenderer.destroy();
+        frameUniforms.destroy();
+        glfwMakeContextCurrent(previousContext);
+        setCurrentGLState(previousState);
+    }
+    simulation.stop();
+    if (window != nullptr) glfwDestroyWindow(window);
+    window = nullptr;
+}
+
+void AquariumWindow::renderLoop()
+{
+    glfwMakeContextCurrent(window);
+    setCurrentGLState(&state);
+    glfwSwapInterval(1);
+
+    std::vector<FishState> visibleFish;
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point lastSwap = Clock::now();
+    bool hasLastSwap = false;
+    while (running.load())
+    {
+        int width = framebufferWidth.load(), height = framebufferHeight.load();
+        if (width <= 0 || height <= 0)
+        {
+            //Minimizovan prozor: nema sta da se crta, a swap bi mogao da ceka neograniceno
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            hasLastSwap = false;
+            continue;
+        }
+        glState().beginFrame();
+        glState().bindFramebuffer(GL_FRAMEBUFFER, 0);
+        glState().viewport(0, 0, width, height);
+
+        const AquariumSnapshot& snapshot = simulation.acquireSnapshot();
+        interpolateFish(snapshot.previous, snapshot.current, simulation.getAlpha(snapshot), visibleFish);
+        float time = (float)simulationClock();
+        frameData.deltaTime = time - frameData.time;
+        frameData.time = time;
+        frameData.resolution[0] = (float)width;
+        frameData.resolution[1] = (float)height;
+        frameUniforms.update(frameData);
+
+        glClear(GL_COLOR_BUFFER_BIT);
+        fishRenderer.draw(visibleFish, snapshot.food);
+        frameUniforms.endFrame();
+        glfwSwapBuffers(window);
+
+        Clock::time_point now = Clock::now();
+        if (hasLastSwap)
+        {
+            double frameSeconds = std::chrono::duration<double>(now - lastSwap).count();
+            frames++;
+            totalFrameSeconds += frameSeconds;
+            if (frameSeconds > maxFrameSeconds) maxFrameSeconds = frameSeconds;
+        }
+        lastSwap = now;
+        hasLastSwap = true;
+    }
+
+    //Objekti koji se ne dijele (VAO) moraju se obrisati u svom kontekstu
+    fishRenderer.destroy();
+    frameUniforms.destroy();
+    glFinish();
+    setCurrentGLState(nullptr);
+    glfwMakeContextCurrent(NULL);
+}
+
+AquariumWindowStats AquariumWindow::getStats() const
+{
+    AquariumWindowStats stats;
+    stats.frames = frames;
+    stats.averageMs = frames > 0 ? totalFrameSeconds / frames * 1000.0 : 0;
+    stats.maxMs = maxFrameSeconds * 1000.0;
+    return stats;
+}
+
+void AquariumWindow::printReport() const
+{
+    AquariumWindowStats stats = getStats();
+    SimulationThreadStats simulationStats = simulation.getStats();
+    std::cout << "Prozor " << index + 1 << ": " << stats.frames << " frejmova, prosjek " << stats.averageMs << " ms, najduzi "
+        << stats.maxMs << " ms, " << simulationStats.ticks << " koraka simulacije" << std::endl;
+}
+
+int parseWindowCount(int argc, char** argv)
+{
+    int count = 1;
+    for (int i = 1; i + 1 < argc; i++)
+        if (std::string(argv[i]) == "--windows") count = std::atoi(argv[i + 1]);
+    return count > 1 ? count : 1;
+}
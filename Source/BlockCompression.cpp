@@ -0,0 +1,807 @@
+#include "../Header/BlockCompression.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BC_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "../Header/GLStateCache.h"
+#include "../Header/JobSystem.h"
+
+// Opis: koder i dekoder za BC1 (DXT1), BC3 (DXT5) i BC7 (samo mod 6) blokove.
+// Krajnje boje bloka se traze po glavnoj osi (PCA) pa se jednom popravljaju metodom najmanjih kvadrata.
+
+namespace {
+
+// Pikseli jednog bloka razdvojeni po kanalima, da bi se projekcije racunale za 4 piksela odjednom
+struct BlockPixels {
+    alignas(16) float channel[4][16]; // r, g, b, a
+};
+
+// Tezine interpolacije BC7 sa 4-bitnim indeksima (od 64), iz specifikacije; mod 6 koristi samo 4-bitne indekse
+const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+// Indeks cija je tezina najbliza datoj vrijednosti 0..64
+const unsigned char BC7_NEAREST_INDEX[65] = {
+    0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3,
+    4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 6, 7, 7, 7,
+    7, 8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 10, 11, 11,
+    11, 11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 14, 15,
+    15,
+};
+
+void loadBlock(const unsigned char* rgba, int width, int height, int blockX, int blockY, BlockPixels& block)
+{
+    //Blokovi na ivici slike koja nije djeljiva sa 4 ponavljaju zadnji red/kolonu
+    for (int y = 0; y < 4; y++)
+    {
+        int sy = std::min(blockY * 4 + y, height - 1);
+        for (int x = 0; x < 4; x++)
+        {
+            int sx = std::min(blockX * 4 + x, width - 1);
+            const unsigned char* pixel = rgba + ((size_t)sy * width + sx) * 4;
+            for (int c = 0; c < 4; c++)
+                block.channel[c][y * 4 + x] = pixel[c];
+        }
+    }
+}
+
+// out[i] = (piksel[i] - origin) . dir, za prvih "channels" kanala
+void projectBlock(const BlockPixels& block, int channels, const float origin[4], const float dir[4], float out[16])
+{
+#ifdef BC_USE_SSE2
+    for (int i = 0; i < 16; i += 4)
+    {
+        __m128 sum = _mm_setzero_ps();
+        for (int c = 0; c < channels; c++)
+        {
+            __m128 value = _mm_sub_ps(_mm_load_ps(&block.channel[c][i]), _mm_set1_ps(origin[c]));
+            sum = _mm_add_ps(sum, _mm_mul_ps(value, _mm_set1_ps(dir[c])));
+        }
+        _mm_storeu_ps(out + i, sum);
+    }
+#else
+    for (int i = 0; i < 16; i++)
+    {
+        float sum = 0;
+        for (int c = 0; c < channels; c++)
+            sum += (block.channel[c][i] - origin[c]) * dir[c];
+        out[i] = sum;
+    }
+#endif
+}
+
+// Za svaki piksel trazi najblizi od steps+1 ravnomjernih koraka na duzi e0-e1
+void quantizeAlongLine(const BlockPixels& block, int channels, const float e0[4], const float e1[4], int steps, int out[16])
+{
+    float dir[4] = { 0, 0, 0, 0 };
+    float lengthSq = 0;
+    for (int c = 0; c < channels; c++)
+    {
+        dir[c] = e1[c] - e0[c];
+        lengthSq += dir[c] * dir[c];
+    }
+    if (lengthSq < 1e-6f)
+    {
+        for (int i = 0; i < 16; i++) out[i] = 0;
+        return;
+    }
+    for (int c = 0; c < channels; c++)
+        dir[c] *= steps / lengthSq;
+
+    float t[16];
+    projectBlock(block, channels, e0, dir, t);
+#ifdef BC_USE_SSE2
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 maxStep = _mm_set1_ps((float)steps);
+    for (int i = 0; i < 16; i += 4)
+    {
+        __m128 value = _mm_add_ps(_mm_loadu_ps(t + i), half);
+        value = _mm_max_ps(_mm_setzero_ps(), _mm_min_ps(value, maxStep));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_cvttps_epi32(value));
+    }
+#else
+    for (int i = 0; i < 16; i++)
+    {
+        float value = std::max(0.0f, std::min(t[i] + 0.5f, (float)steps));
+        out[i] = (int)value;
+    }
+#endif
+}
+
+void principalAxis(const BlockPixels& block, int channels, float mean[4], float axis[4])
+{
+    for (int c = 0; c < 4; c++)
+    {
+        float sum = 0;
+        for (int i = 0; i < 16; i++) sum += block.channel[c][i];
+        mean[c] = sum / 16.0f;
+        axis[c] = 0;
+    }
+
+    float covariance[4][4] = {};
+    for (int i = 0; i < 16; i++)
+    {
+        float d[4];
+        for (int c = 0; c < channels; c++) d[c] = block.channel[c][i] - mean[c];
+        for (int a = 0; a < channels; a++)
+            for (int b = a; b < channels; b++)
+                covariance[a][b] += d[a] * d[b];
+    }
+    for (int a = 0; a < channels; a++)
+        for (int b = 0; b < a; b++)
+            covariance[a][b] = covariance[b][a];
+
+    //Pocinjemo od kanala sa najvecom varijansom pa stepenom metodom trazimo sopstveni vektor
+    int widest = 0;
+    for (int c = 1; c < channels; c++)
+        if (covariance[c][c] > covariance[widest][widest]) widest = c;
+    if (covariance[widest][widest] < 1e-4f)
+    {
+        axis[0] = 1; //Blok je jednobojan, osa nije bitna
+        return;
+    }
+    float v[4] = { 0, 0, 0, 0 };
+    for (int c = 0; c < channels; c++) v[c] = covariance[widest][c];
+
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[4] = { 0, 0, 0, 0 };
+        float largest = 0;
+        for (int a = 0; a < channels; a++)
+        {
+            for (int b = 0; b < channels; b++) next[a] += covariance[a][b] * v[b];
+            largest = std::max(largest, std::fabs(next[a]));
+        }
+        if (largest < 1e-8f) break;
+        for (int c = 0; c < channels; c++) v[c] = next[c] / largest;
+    }
+
+    float length = 0;
+    for (int c = 0; c < channels; c++) length += v[c] * v[c];
+    length = std::sqrt(length);
+    for (int c = 0; c < channels; c++) axis[c] = v[c] / length;
+}
+
+// Krajnje tacke duzi koja obuhvata sve projekcije piksela na glavnu osu
+void endpointsFromAxis(const BlockPixels& block, int channels, float e0[4], float e1[4])
+{
+    float mean[4], axis[4], t[16];
+    principalAxis(block, channels, mean, axis);
+    projectBlock(block, channels, mean, axis, t);
+    float minT = t[0], maxT = t[0];
+    for (int i = 1; i < 16; i++)
+    {
+        minT = std::min(minT, t[i]);
+        maxT = std::max(maxT, t[i]);
+    }
+    for (int c = 0; c < 4; c++)
+    {
+        e0[c] = std::max(0.0f, std::min(255.0f, mean[c] + axis[c] * minT));
+        e1[c] = std::max(0.0f, std::min(255.0f, mean[c] + axis[c] * maxT));
+    }
+}
+
+// Metoda najmanjih kvadrata: za date indekse trazi krajnje tacke sa najmanjom greskom.
+// weights[s] je udio druge krajnje tacke za korak s.
+bool refineEndpoints(const BlockPixels& block, int channels, const int steps[16], const float* weights, float e0[4], float e1[4])
+{
+    float aa = 0, bb = 0, ab = 0;
+    float ax[4] = { 0, 0, 0, 0 }, bx[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 16; i++)
+    {
+        float b = weights[steps[i]];
+        float a = 1.0f - b;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < channels; c++)
+        {
+            ax[c] += a * block.channel[c][i];
+            bx[c] += b * block.channel[c][i];
+        }
+    }
+    float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f) return false;
+    for (int c = 0; c < channels; c++)
+    {
+        e0[c] = std::max(0.0f, std::min(255.0f, (ax[c] * bb - bx[c] * ab) / determinant));
+        e1[c] = std::max(0.0f, std::min(255.0f, (bx[c] * aa - ax[c] * ab) / determinant));
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------- BC1 / BC3
+
+unsigned short pack565(const float color[4])
+{
+    int r = (int)(color[0] * 31.0f / 255.0f + 0.5f);
+    int g = (int)(color[1] * 63.0f / 255.0f + 0.5f);
+    int b = (int)(color[2] * 31.0f / 255.0f + 0.5f);
+    return (unsigned short)((r << 11) | (g << 5) | b);
+}
+
+void unpack565(unsigned short packed, float color[4])
+{
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = (float)((r << 3) | (r >> 2));
+    color[1] = (float)((g << 2) | (g >> 4));
+    color[2] = (float)((b << 3) | (b >> 2));
+    color[3] = 255.0f;
+}
+
+const float BC1_WEIGHTS[4] = { 0.0f, 1.0f / 3.0f, 2.0f / 3.0f, 1.0f };
+
+// Kvantizuje krajnje tacke u 565, bira indekse i vraca gresku
+float fitColorEndpoints(const BlockPixels& block, const float e0[4], const float e1[4], unsigned short packed[2], int steps[16])
+{
+    float q0[4], q1[4];
+    packed[0] = pack565(e0);
+    packed[1] = pack565(e1);
+    unpack565(packed[0], q0);
+    unpack565(packed[1], q1);
+    quantizeAlongLine(block, 3, q0, q1, 3, steps);
+
+    float error = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        float w = BC1_WEIGHTS[steps[i]];
+        for (int c = 0; c < 3; c++)
+        {
+            float d = q0[c] + (q1[c] - q0[c]) * w - block.channel[c][i];
+            error += d * d;
+        }
+    }
+    return error;
+}
+
+void encodeColorBlock(const BlockPixels& block, unsigned char out[8])
+{
+    float e0[4], e1[4];
+    endpointsFromAxis(block, 3, e0, e1);
+
+    unsigned short packed[2];
+    int steps[16];
+    float error = fitColorEndpoints(block, e0, e1, packed, steps);
+
+    if (refineEndpoints(block, 3, steps, BC1_WEIGHTS, e0, e1))
+    {
+        unsigned short refinedPacked[2];
+        int refinedSteps[16];
+        float refinedError = fitColorEndpoints(block, e0, e1, refinedPacked, refinedSteps);
+        if (refinedError < error)
+        {
+            memcpy(packed, refinedPacked, sizeof(packed));
+            memcpy(steps, refinedSteps, sizeof(steps));
+        }
+    }
+
+    //Mod sa 4 boje se bira tako sto je prva boja veca od druge
+    if (packed[0] < packed[1])
+    {
+        std::swap(packed[0], packed[1]);
+        for (int i = 0; i < 16; i++) steps[i] = 3 - steps[i];
+    }
+    else if (packed[0] == packed[1])
+    {
+        for (int i = 0; i < 16; i++) steps[i] = 0;
+    }
+
+    //Korak na duzi -> indeks u paleti (0 = prva boja, 1 = druga, 2 i 3 su medjuboje)
+    const unsigned STEP_TO_INDEX[4] = { 0, 2, 3, 1 };
+    unsigned indices = 0;
+    for (int i = 0; i < 16; i++)
+        indices |= STEP_TO_INDEX[steps[i]] << (i * 2);
+
+    out[0] = packed[0] & 0xff;
+    out[1] = packed[0] >> 8;
+    out[2] = packed[1] & 0xff;
+    out[3] = packed[1] >> 8;
+    for (int i = 0; i < 4; i++) out[4 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+void encodeAlphaBlock(const BlockPixels& block, unsigned char out[8])
+{
+    float minAlpha = block.channel[3][0], maxAlpha = block.channel[3][0];
+    for (int i = 1; i < 16; i++)
+    {
+        minAlpha = std::min(minAlpha, block.channel[3][i]);
+        maxAlpha = std::max(maxAlpha, block.channel[3][i]);
+    }
+    out[0] = (unsigned char)maxAlpha;
+    out[1] = (unsigned char)minAlpha;
+
+    //a0 > a1 bira mod sa 8 nivoa: indeks 0 = a0, 1 = a1, 2..7 su medjunivoi od a0 ka a1
+    unsigned long long indices = 0;
+    if (maxAlpha > minAlpha)
+    {
+        float scale = 7.0f / (maxAlpha - minAlpha);
+        for (int i = 0; i < 16; i++)
+        {
+            int level = (int)((block.channel[3][i] - minAlpha) * scale + 0.5f);
+            unsigned long long index = level == 7 ? 0 : (level == 0 ? 1 : 8 - level);
+            indices |= index << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+void decodeColorBlock(const unsigned char* in, bool allowThreeColor, unsigned char out[16][4])
+{
+    unsigned short c0 = (unsigned short)(in[0] | (in[1] << 8));
+    unsigned short c1 = (unsigned short)(in[2] | (in[3] << 8));
+    float q0[4], q1[4];
+    unpack565(c0, q0);
+    unpack565(c1, q1);
+
+    unsigned char palette[4][4];
+    for (int c = 0; c < 4; c++)
+    {
+        palette[0][c] = (unsigned char)q0[c];
+        palette[1][c] = (unsigned char)q1[c];
+        if (c0 > c1 || !allowThreeColor)
+        {
+            palette[2][c] = (unsigned char)((2 * q0[c] + q1[c]) / 3.0f + 0.5f);
+            palette[3][c] = (unsigned char)((q0[c] + 2 * q1[c]) / 3.0f + 0.5f);
+        }
+        else
+        {
+            palette[2][c] = (unsigned char)((q0[c] + q1[c]) / 2.0f + 0.5f);
+            palette[3][c] = 0; //Providna crna
+        }
+    }
+
+    unsigned indices = in[4] | (in[5] << 8) | (in[6] << 16) | ((unsigned)in[7] << 24);
+    for (int i = 0; i < 16; i++)
+        memcpy(out[i], palette[(indices >> (i * 2)) & 3], 4);
+}
+
+void decodeAlphaBlock(const unsigned char* in, unsigned char out[16][4])
+{
+    int a0 = in[0], a1 = in[1];
+    int palette[8] = { a0, a1 };
+    if (a0 > a1)
+    {
+        for (int i = 2; i < 8; i++) palette[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+    }
+    else
+    {
+        for (int i = 2; i < 6; i++) palette[i] = ((6 - i) * a0 + (i - 1) * a1 + 2) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    unsigned long long indices = 0;
+    for (int i = 0; i < 6; i++) indices |= (unsigned long long)in[2 + i] << (i * 8);
+    for (int i = 0; i < 16; i++)
+        out[i][3] = (unsigned char)palette[(indices >> (i * 3)) & 7];
+}
+
+// ---------------------------------------------------------------- BC7 (mod 6)
+
+struct BitWriter {
+    unsigned char* out;
+    int position = 0;
+
+    void write(unsigned value, int bits)
+    {
+        for (int i = 0; i < bits; i++, position++)
+        {
+            if (value & (1u << i)) out[position / 8] |= (unsigned char)(1u << (position % 8));
+        }
+    }
+};
+
+unsigned readBits(const unsigned char* in, int& position, int bits)
+{
+    unsigned value = 0;
+    for (int i = 0; i < bits; i++, position++)
+        value |= ((in[position / 8] >> (position % 8)) & 1u) << i;
+    return value;
+}
+
+// Krajnja tacka moda 6: 7 bita po kanalu + jedan zajednicki p-bit koji postaje najnizi bit
+struct BC7Endpoint {
+    int value[4];
+    int pBit;
+};
+
+BC7Endpoint quantizeBC7Endpoint(const float color[4])
+{
+    BC7Endpoint best = {};
+    float bestError = 1e30f;
+    for (int pBit = 0; pBit < 2; pBit++)
+    {
+        BC7Endpoint candidate;
+        candidate.pBit = pBit;
+        float error = 0;
+        for (int c = 0; c < 4; c++)
+        {
+            int q = (int)((color[c] - pBit) / 2.0f + 0.5f);
+            candidate.value[c] = std::max(0, std::min(127, q));
+            float d = (float)((candidate.value[c] << 1) | pBit) - color[c];
+            error += d * d;
+        }
+        if (error < bestError)
+        {
+            bestError = error;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+void expandBC7Endpoint(const BC7Endpoint& endpoint, float color[4])
+{
+    for (int c = 0; c < 4; c++) color[c] = (float)((endpoint.value[c] << 1) | endpoint.pBit);
+}
+
+float fitBC7Endpoints(const BlockPixels& block, const float e0[4], const float e1[4], BC7Endpoint quantized[2], int steps[16])
+{
+    float q0[4], q1[4];
+    quantized[0] = quantizeBC7Endpoint(e0);
+    quantized[1] = quantizeBC7Endpoint(e1);
+    expandBC7Endpoint(quantized[0], q0);
+    expandBC7Endpoint(quantized[1], q1);
+    //BC7 tezine nisu ravnomjerne (0, 4, 9, 13 ... od 64), pa se pikseli projektuju na skalu 0..64 i uzima indeks
+    //najblize tezine; greska se racuna kao u dekoderu, sa cjelobrojnim zaokruzivanjem
+    int weightSteps[16];
+    quantizeAlongLine(block, 4, q0, q1, 64, weightSteps);
+
+    float error = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        steps[i] = BC7_NEAREST_INDEX[weightSteps[i]];
+        int w = BC7_WEIGHTS[steps[i]];
+        for (int c = 0; c < 4; c++)
+        {
+            float d = (float)(((64 - w) * (int)q0[c] + w * (int)q1[c] + 32) >> 6) - block.channel[c][i];
+            error += d * d;
+        }
+    }
+    return error;
+}
+
+void encodeBC7Block(const BlockPixels& block, unsigned char out[16])
+{
+    float weights[16];
+    for (int i = 0; i < 16; i++) weights[i] = BC7_WEIGHTS[i] / 64.0f;
+
+    float e0[4], e1[4];
+    endpointsFromAxis(block, 4, e0, e1);
+
+    BC7Endpoint quantized[2];
+    int steps[16];
+    float error = fitBC7Endpoints(block, e0, e1, quantized, steps);
+
+    if (refineEndpoints(block, 4, steps, weights, e0, e1))
+    {
+        BC7Endpoint refinedQuantized[2];
+        int refinedSteps[16];
+        float refinedError = fitBC7Endpoints(block, e0, e1, refinedQuantized, refinedSteps);
+        if (refinedError < error)
+        {
+            quantized[0] = refinedQuantized[0];
+            quantized[1] = refinedQuantized[1];
+            memcpy(steps, refinedSteps, sizeof(steps));
+        }
+    }
+
+    //Najvisi bit indeksa prvog piksela se ne cuva (mora biti 0), pa po potrebi mijenjamo mjesta krajnjim tackama
+    if (steps[0] >= 8)
+    {
+        std::swap(quantized[0], quantized[1]);
+        for (int i = 0; i < 16; i++) steps[i] = 15 - steps[i];
+    }
+
+    memset(out, 0, 16);
+    BitWriter writer{ out };
+    writer.write(1u << 6, 7); //Mod 6
+    for (int c = 0; c < 4; c++)
+    {
+        writer.write((unsigned)quantized[0].value[c], 7);
+        writer.write((unsigned)quantized[1].value[c], 7);
+    }
+    writer.write((unsigned)quantized[0].pBit, 1);
+    writer.write((unsigned)quantized[1].pBit, 1);
+    writer.write((unsigned)steps[0], 3);
+    for (int i = 1; i < 16; i++) writer.write((unsigned)steps[i], 4);
+}
+
+void decodeBC7Block(const unsigned char* in, unsigned char out[16][4])
+{
+    if ((in[0] & 0x7f) != 0x40)
+    {
+        //Ostale modove ovaj koder ne pravi
+        for (int i = 0; i < 16; i++) out[i][0] = out[i][1] = out[i][2] = out[i][3] = 0;
+        return;
+    }
+
+    int position = 7;
+    int endpoints[2][4];
+    for (int c = 0; c < 4; c++)
+    {
+        endpoints[0][c] = (int)readBits(in, position, 7);
+        endpoints[1][c] = (int)readBits(in, position, 7);
+    }
+    int p0 = (int)readBits(in, position, 1);
+    int p1 = (int)readBits(in, position, 1);
+    for (int c = 0; c < 4; c++)
+    {
+        endpoints[0][c] = (endpoints[0][c] << 1) | p0;
+        endpoints[1][c] = (endpoints[1][c] << 1) | p1;
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        int w = BC7_WEIGHTS[readBits(in, position, i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; c++)
+            out[i][c] = (unsigned char)(((64 - w) * endpoints[0][c] + w * endpoints[1][c] + 32) >> 6);
+    }
+}
+
+// ----------------------------------------------------------------
+
+int blockBytes(TextureCompression format)
+{
+    return format == TextureCompression::BC1 ? 8 : 16;
+}
+
+void encodeBlock(TextureCompression format, const BlockPixels& block, unsigned char* out)
+{
+    switch (format) {
+    case TextureCompression::BC1: encodeColorBlock(block, out); break;
+    case TextureCompression::BC3: encodeAlphaBlock(block, out); encodeColorBlock(block, out + 8); break;
+    case TextureCompression::BC7: encodeBC7Block(block, out); break;
+    default: break;
+    }
+}
+
+void expandToRGBA(const unsigned char* pixels, int channels, size_t pixelCount, unsigned char* rgba)
+{
+    //Isto kao sto OpenGL cita GL_RED/GL_RG/GL_RGB teksture: kanali koji fale su 0, alfa je 255
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        for (int c = 0; c < 4; c++)
+            rgba[i * 4 + c] = c < channels ? pixels[i * channels + c] : (c == 3 ? 255 : 0);
+    }
+}
+
+double computePSNR(const unsigned char* a, const unsigned char* b, size_t pixelCount, int channels)
+{
+    double sum = 0;
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        for (int c = 0; c < channels; c++)
+        {
+            double d = (double)a[i * 4 + c] - (double)b[i * 4 + c];
+            sum += d * d;
+        }
+    }
+    double mse = sum / ((double)pixelCount * channels);
+    if (mse <= 0) return 99.0;
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+const char* compressionName(TextureCompression format)
+{
+    switch (format) {
+    case TextureCompression::BC1: return "BC1";
+    case TextureCompression::BC3: return "BC3";
+    case TextureCompression::BC7: return "BC7";
+    default: return "nekompresovano";
+    }
+}
+
+}
+
+bool isTextureCompressionSupported(TextureCompression format)
+{
+    switch (format) {
+    case TextureCompression::BC1:
+    case TextureCompression::BC3: return GLEW_EXT_texture_compression_s3tc;
+    case TextureCompression::BC7: return GLEW_ARB_texture_compression_bptc;
+    default: return false;
+    }
+}
+
+TextureCompression resolveTextureCompression(TextureCompression requested, bool hasAlpha)
+{
+    if (requested == TextureCompression::Auto)
+    {
+        if (!hasAlpha) requested = TextureCompression::BC1;
+        else if (isTextureCompressionSupported(TextureCompression::BC7)) requested = TextureCompression::BC7;
+        else requested = TextureCompression::BC3;
+    }
+    if (requested == TextureCompression::None || !isTextureCompressionSupported(requested)) return TextureCompression::None;
+    return requested;
+}
+
+GLenum textureCompressionFormat(TextureCompression format)
+{
+    switch (format) {
+    case TextureCompression::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case TextureCompression::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case TextureCompression::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    default: return 0;
+    }
+}
+
+size_t blockCompressedSize(TextureCompression format, int width, int height)
+{
+    size_t blocksX = (size_t)(width + 3) / 4;
+    size_t blocksY = (size_t)(height + 3) / 4;
+    return blocksX * blocksY * blockBytes(format);
+}
+
+void compressImageBlocks(TextureCompression format, const unsigned char* rgba, int width, int height, unsigned char* blocks, JobSystem* jobs)
+{
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    int bytes = blockBytes(format);
+    if (jobs == nullptr) jobs = &jobSystem();
+
+    //Redovi blokova se dijele na vise dijelova nego niti, pa kradja posla izravna dijelove slike razlicite slozenosti.
+    //Mali mip nivoi (ispod 256 blokova) ne vrijede raspodjele i rade se odmah.
+    int grain = std::max(1, 256 / std::max(1, blocksX));
+    jobs->parallelFor(0, blocksY, grain, [&](int firstRow, int lastRow) {
+        BlockPixels block;
+        for (int row = firstRow; row < lastRow; row++)
+        {
+            unsigned char* out = blocks + (size_t)row * blocksX * bytes;
+            for (int x = 0; x < blocksX; x++, out += bytes)
+            {
+                loadBlock(rgba, width, height, x, row, block);
+                encodeBlock(format, block, out);
+            }
+        }
+    });
+}
+
+void decompressImageBlocks(TextureCompression format, const unsigned char* blocks, int width, int height, unsigned char* rgba)
+{
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    int bytes = blockBytes(format);
+    unsigned char decoded[16][4];
+
+    for (int by = 0; by < blocksY; by++)
+    {
+        for (int bx = 0; bx < blocksX; bx++)
+        {
+            const unsigned char* in = blocks + ((size_t)by * blocksX + bx) * bytes;
+            switch (format) {
+            case TextureCompression::BC1: decodeColorBlock(in, true, decoded); break;
+            case TextureCompression::BC3: decodeColorBlock(in + 8, false, decoded); decodeAlphaBlock(in, decoded); break;
+            case TextureCompression::BC7: decodeBC7Block(in, decoded); break;
+            default: return;
+            }
+            for (int y = 0; y < 4 && by * 4 + y < height; y++)
+                for (int x = 0; x < 4 && bx * 4 + x < width; x++)
+                    memcpy(rgba + ((size_t)(by * 4 + y) * width + bx * 4 + x) * 4, decoded[y * 4 + x], 4);
+        }
+    }
+}
+
+bool textureImageHasAlpha(const TextureImage& image)
+{
+    if (image.compressed || image.format != GL_RGBA || image.levels.empty()) return false;
+    const TextureLevel& level = image.levels[0];
+    for (size_t i = 3; i < level.size; i += 4)
+        if (image.pixels[level.offset + i] != 255) return true;
+    return false;
+}
+
+bool compressTextureImage(TextureImage& image, TextureCompression requested)
+{
+    if (image.compressed || image.levels.empty()) return false;
+    TextureCompression format = resolveTextureCompression(requested, textureImageHasAlpha(image));
+    if (format == TextureCompression::None) return false;
+    return encodeTextureImage(image, format);
+}
+
+bool encodeTextureImage(TextureImage& image, TextureCompression format)
+{
+    int channels = textureChannelsForFormat(image.format);
+    if (image.compressed || channels == 0 || image.levels.empty() || textureCompressionFormat(format) == 0) return false;
+
+    std::vector<TextureLevel> levels(image.levels.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        levels[i].width = image.levels[i].width;
+        levels[i].height = image.levels[i].height;
+        levels[i].offset = offset;
+        levels[i].size = blockCompressedSize(format, levels[i].width, levels[i].height);
+        offset += levels[i].size;
+    }
+
+    std::vector<unsigned char> blocks(offset);
+    std::vector<unsigned char> rgba;
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        const TextureLevel& source = image.levels[i];
+        size_t pixelCount = (size_t)source.width * source.height;
+        rgba.resize(pixelCount * 4);
+        expandToRGBA(&image.pixels[source.offset], channels, pixelCount, rgba.data());
+        compressImageBlocks(format, rgba.data(), source.width, source.height, &blocks[levels[i].offset]);
+    }
+
+    image.format = textureCompressionFormat(format);
+    image.compressed = true;
+    image.levels.swap(levels);
+    image.pixels.swap(blocks);
+    return true;
+}
+
+void printBlockCompressionReport(const char* filePath)
+{
+    TextureImage image;
+    if (!decodeImageFile(filePath, TextureLoadOptions(), image))
+    {
+        std::cout << "Slika nije ucitana! Putanja slike: " << filePath << std::endl;
+        return;
+    }
+    int width = image.levels[0].width;
+    int height = image.levels[0].height;
+    size_t pixelCount = (size_t)width * height;
+    std::vector<unsigned char> source(pixelCount * 4);
+    expandToRGBA(image.pixels.data(), textureChannelsForFormat(image.format), pixelCount, source.data());
+
+    unsigned hardwareThreads = jobSystem().getThreadCount();
+    JobSystem singleThread(1);
+    std::cout << "Blok kompresija \"" << filePath << "\" (" << width << "x" << height << ", "
+        << hardwareThreads << " niti, SIMD: "
+#ifdef BC_USE_SSE2
+        << "SSE2"
+#else
+        << "nema"
+#endif
+        << ")" << std::endl;
+
+    const TextureCompression formats[] = { TextureCompression::BC1, TextureCompression::BC3, TextureCompression::BC7 };
+    for (TextureCompression format : formats)
+    {
+        std::vector<unsigned char> blocks(blockCompressedSize(format, width, height));
+        std::vector<unsigned char> decoded(pixelCount * 4);
+        int channels = format == TextureCompression::BC1 ? 3 : 4; //BC1 ne cuva alfa kanal
+
+        auto start = std::chrono::steady_clock::now();
+        compressImageBlocks(format, source.data(), width, height, blocks.data(), &singleThread);
+        double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        compressImageBlocks(format, source.data(), width, height, blocks.data());
+        double parallelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        decompressImageBlocks(format, blocks.data(), width, height, decoded.data());
+        double cpuPSNR = computePSNR(source.data(), decoded.data(), pixelCount, channels);
+
+        std::cout << "  " << compressionName(format) << ": PSNR " << cpuPSNR << " dB"
+            << ", 1 nit " << singleSeconds * 1000.0 << " ms (" << pixelCount / singleSeconds / 1e6 << " MPix/s)"
+            << ", " << hardwareThreads << " niti " << parallelSeconds * 1000.0 << " ms (" << pixelCount / parallelSeconds / 1e6 << " MPix/s)";
+
+        //Isti blokovi dekodovani na grafickoj kartici (ili u Mesa drajveru), da provjerimo da ih drajver cita kao i mi
+        if (isTextureCompressionSupported(format))
+        {
+            unsigned texture;
+            glGenTextures(1, &texture);
+            glState().bindTextureUnit(0, GL_TEXTURE_2D, texture);
+            glCompressedTexImage2D(GL_TEXTURE_2D, 0, textureCompressionFormat(format), width, height, 0, (GLsizei)blocks.size(), blocks.data());
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, decoded.data());
+            glState().deleteTexture(texture);
+            std::cout << ", PSNR na GPU " << computePSNR(source.data(), decoded.data(), pixelCount, channels) << " dB";
+        }
+        else
+        {
+            std::cout << ", drajver ne podrzava format";
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,536 @@
+#include "../Header/Boids.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOIDS_USE_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(_MSC_VER)
+//AVX2 funkcije se prevode i bez /arch:AVX2 (-mavx2), a pozivaju samo ako ih procesor ima
+#define BOIDS_USE_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define BOIDS_TARGET_AVX2
+#else
+#define BOIDS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+#endif
+
+// Opis: jato riba (razdvajanje, poravnanje, kohezija) preko uniformne mreze sortirane prebrojavanjem,
+// sa skalarnom, SSE2 i AVX2 unutrasnjom petljom po susjedima
+
+static const int GRID_MAX_CELLS = 1 << 20;
+static const int SIMD_PADDING = 8; // Najsira SIMD verzija (AVX2) cita 8 riba odjednom
+
+void BoidsFish::resize(size_t count)
+{
+    x.resize(count);
+    y.resize(count);
+    dirX.resize(count);
+    dirY.resize(count);
+}
+
+void SpatialGrid::build(const float* x, const float* y, int count, float left, float bottom, float right, float top,
+    float cellSize)
+{
+    minX = left;
+    minY = bottom;
+    float width = std::max(right - left, 0.0f), height = std::max(top - bottom, 0.0f);
+    cellSize = std::max(cellSize, 1e-6f);
+    columns = std::max(1, (int)std::ceil(width / cellSize));
+    rows = std::max(1, (int)std::ceil(height / cellSize));
+    while ((long long)columns * rows > GRID_MAX_CELLS)
+    {
+        //Vece celije su i dalje ispravne (susjedi su u susjednim celijama), samo se gleda vise riba
+        cellSize *= 2.0f;
+        columns = std::max(1, (int)std::ceil(width / cellSize));
+        rows = std::max(1, (int)std::ceil(height / cellSize));
+    }
+    inverseCellSize = 1.0f / cellSize;
+
+    //Broj riba po celiji, na mjestu iza celije, pa prefiksna suma daje pocetak svake celije
+    int cellCount = columns * rows;
+    cellStarts.assign(cellCount + 1, 0);
+    cellOfFish.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        int cell = getCellY(y[i]) * columns + getCellX(x[i]);
+        cellOfFish[i] = cell;
+        cellStarts[cell + 1]++;
+    }
+    for (int cell = 0; cell < cellCount; cell++) cellStarts[cell + 1] += cellStarts[cell];
+
+    //Raspored: cellStarts[cell] se koristi kao kursor i pomjera do kraja celije, pa se vraca za jedno mjesto
+    order.resize(count);
+    for (int i = 0; i < count; i++) order[cellStarts[cellOfFish[i]]++] = i;
+    for (int cell = cellCount; cell > 0; cell--) cellStarts[cell] = cellStarts[cell - 1];
+    cellStarts[0] = 0;
+}
+
+int SpatialGrid::getCellX(float x) const
+{
+    //Ribe van mreze idu u rubne celije; susjedi i dalje ostaju u susjednim celijama
+    int cell = (int)((x - minX) * inverseCellSize);
+    return std::min(std::max(cell, 0), columns - 1);
+}
+
+int SpatialGrid::getCellY(float y) const
+{
+    int cell = (int)((y - minY) * inverseCellSize);
+    return std::min(std::max(cell, 0), rows - 1);
+}
+
+int SpatialGrid::getNeighborRanges(float x, float y, int ranges[3][2]) const
+{
+    int cellX = getCellX(x), cellY = getCellY(y);
+    int firstColumn = std::max(cellX - 1, 0), lastColumn = std::min(cellX + 1, columns - 1);
+    int count = 0;
+    for (int row = std::max(cellY - 1, 0); row <= std::min(cellY + 1, rows - 1); row++)
+    {
+        ranges[count][0] = getRangeBegin(row, firstColumn);
+        ranges[count][1] = getRangeEnd(row, lastColumn);
+        count++;
+    }
+    return count;
+}
+
+const char* boidsKernelName(BoidsKernel kernel)
+{
+    switch (kernel)
+    {
+    case BoidsKernel::Sse2: return "SSE2";
+    case BoidsKernel::Avx2: return "AVX2";
+    default: return "skalarna";
+    }
+}
+
+static bool cpuSupportsAvx2()
+{
+#if defined(BOIDS_USE_AVX2) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+    //Operativni sistem mora cuvati YMM registre pri promjeni niti
+    if (!osSavesAvx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(BOIDS_USE_AVX2)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+
+bool isBoidsKernelSupported(BoidsKernel kernel)
+{
+    static const bool avx2 = cpuSupportsAvx2();
+    switch (kernel)
+    {
+#ifdef BOIDS_USE_SSE2
+    case BoidsKernel::Sse2: return true;
+#endif
+    case BoidsKernel::Avx2: return avx2;
+    case BoidsKernel::Scalar: return true;
+    default: return false;
+    }
+}
+
+BoidsKernel getBestBoidsKernel()
+{
+    if (isBoidsKernelSupported(BoidsKernel::Avx2)) return BoidsKernel::Avx2;
+    if (isBoidsKernelSupported(BoidsKernel::Sse2)) return BoidsKernel::Sse2;
+    return BoidsKernel::Scalar;
+}
+
+struct BoidsSums {
+    float separationX = 0;
+    float separationY = 0;
+    float dirX = 0;
+    float dirY = 0;
+    float offsetX = 0; // Zbir pozicija susjeda u odnosu na ribu
+    float offsetY = 0;
+    float count = 0;
+};
+
+// Sabira susjede iz opsega [begin, end); sama riba (i riba na istom mjestu) se preskace
+static void accumulateNeighbors(const BoidsFish& fish, int begin, int end, float px, float py,
+    const BoidsParameters& parameters, BoidsSums& sums)
+{
+    float radius2 = parameters.neighborRadius * parameters.neighborRadius;
+    float separation2 = parameters.separationRadius * parameters.separationRadius;
+    float inverseSeparation = 1.0f / parameters.separationRadius;
+    for (int j = begin; j < end; j++)
+    {
+        float dx = px - fish.x[j], dy = py - fish.y[j];
+        float distance2 = dx * dx + dy * dy;
+        if (distance2 <= 0.0f || distance2 >= radius2) continue;
+        sums.dirX += fish.dirX[j];
+        sums.dirY += fish.dirY[j];
+        sums.offsetX -= dx;
+        sums.offsetY -= dy;
+        sums.count += 1.0f;
+        if (distance2 < separation2)
+        {
+            //Odbijanje od 1 (dodir) do 0 (na rubu razdvajanja)
+            float weight = 1.0f / std::sqrt(distance2) - inverseSeparation;
+            sums.separationX += dx * weight;
+            sums.separationY += dy * weight;
+        }
+    }
+}
+
+static void finishSteer(const BoidsSums& sums, float dirX, float dirY, const BoidsParameters& parameters,
+    float& steerX, float& steerY)
+{
+    steerX = 0;
+    steerY = 0;
+    if (sums.count == 0) return;
+    float inverseCount = 1.0f / sums.count;
+    float inverseRadius = 1.0f / parameters.neighborRadius;
+    steerX = parameters.separationWeight * sums.separationX
+        + parameters.alignmentWeight * (sums.dirX * inverseCount - dirX)
+        + parameters.cohesionWeight * sums.offsetX * inverseCount * inverseRadius;
+    steerY = parameters.separationWeight * sums.separationY
+        + parameters.alignmentWeight * (sums.dirY * inverseCount - dirY)
+        + parameters.cohesionWeight * sums.offsetY * inverseCount * inverseRadius;
+}
+
+// Sabira susjede iz do tri opsega poredanih riba; jedna funkcija po verziji unutrasnje petlje
+typedef void (*AccumulateFunction)(const BoidsFish& fish, const int ranges[3][2], int rangeCount, float px, float py,
+    const BoidsParameters& parameters, BoidsSums& sums);
+
+static void accumulateScalar(const BoidsFish& fish, const int ranges[3][2], int rangeCount, float px, float py,
+    const BoidsParameters& parameters, BoidsSums& sums)
+{
+    for (int r = 0; r < rangeCount; r++) accumulateNeighbors(fish, ranges[r][0], ranges[r][1], px, py, parameters, sums);
+}
+
+#ifdef BOIDS_USE_SSE2
+static float sum4(__m128 value)
+{
+    value = _mm_add_ps(value, _mm_movehl_ps(value, value));
+    value = _mm_add_ss(value, _mm_shuffle_ps(value, value, 1));
+    return _mm_cvtss_f32(value);
+}
+
+// Kao accumulateNeighbors, za 4 susjeda odjednom; susjedi van opsega se odbacuju maskom po indeksu
+static void accumulateSse2(const BoidsFish& fish, const int ranges[3][2], int rangeCount, float px, float py,
+    const BoidsParameters& parameters, BoidsSums& sums)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 radius2 = _mm_set1_ps(parameters.neighborRadius * parameters.neighborRadius);
+    const __m128 separation2 = _mm_set1_ps(parameters.separationRadius * parameters.separationRadius);
+    const __m128 inverseSeparation = _mm_set1_ps(1.0f / parameters.separationRadius);
+    const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128 x = _mm_set1_ps(px), y = _mm_set1_ps(py);
+    __m128 separationX = zero, separationY = zero, dirX = zero, dirY = zero, offsetX = zero, offsetY = zero;
+    __m128 neighbors = zero;
+    for (int r = 0; r < rangeCount; r++)
+        for (int j = ranges[r][0]; j < ranges[r][1]; j += 4)
+        {
+            __m128 inRange = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_set1_epi32(ranges[r][1] - j), lanes));
+            __m128 dx = _mm_sub_ps(x, _mm_loadu_ps(&fish.x[j]));
+            __m128 dy = _mm_sub_ps(y, _mm_loadu_ps(&fish.y[j]));
+            __m128 distance2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 inRadius = _mm_and_ps(inRange, _mm_and_ps(_mm_cmpgt_ps(distance2, zero), _mm_cmplt_ps(distance2, radius2)));
+            if (_mm_movemask_ps(inRadius) == 0) continue;
+            dirX = _mm_add_ps(dirX, _mm_and_ps(inRadius, _mm_loadu_ps(&fish.dirX[j])));
+            dirY = _mm_add_ps(dirY, _mm_and_ps(inRadius, _mm_loadu_ps(&fish.dirY[j])));
+            offsetX = _mm_sub_ps(offsetX, _mm_and_ps(inRadius, dx));
+            offsetY = _mm_sub_ps(offsetY, _mm_and_ps(inRadius, dy));
+            neighbors = _mm_add_ps(neighbors, _mm_and_ps(inRadius, one));
+            __m128 tooClose = _mm_and_ps(inRadius, _mm_cmplt_ps(distance2, separation2));
+            if (_mm_movemask_ps(tooClose) == 0) continue;
+            //1/d: rsqrt (12 bita) i Newtonov korak; maska posle mnozenja brise i beskonacnost za d = 0
+            __m128 inverse = _mm_rsqrt_ps(distance2);
+            inverse = _mm_mul_ps(inverse, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, distance2),
+                _mm_mul_ps(inverse, inverse))));
+            __m128 weight = _mm_sub_ps(inverse, inverseSeparation);
+            separationX = _mm_add_ps(separationX, _mm_and_ps(tooClose, _mm_mul_ps(dx, weight)));
+            separationY = _mm_add_ps(separationY, _mm_and_ps(tooClose, _mm_mul_ps(dy, weight)));
+        }
+    sums.separationX += sum4(separationX);
+    sums.separationY += sum4(separationY);
+    sums.dirX += sum4(dirX);
+    sums.dirY += sum4(dirY);
+    sums.offsetX += sum4(offsetX);
+    sums.offsetY += sum4(offsetY);
+    sums.count += sum4(neighbors);
+}
+#endif
+
+#ifdef BOIDS_USE_AVX2
+BOIDS_TARGET_AVX2 static float sum8(__m256 value)
+{
+    __m128 low = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+    low = _mm_add_ps(low, _mm_movehl_ps(low, low));
+    low = _mm_add_ss(low, _mm_shuffle_ps(low, low, 1));
+    return _mm_cvtss_f32(low);
+}
+
+// Isto kao accumulateSse2, za 8 susjeda odjednom. Iz AVX koda se ne poziva nista sto nije prevedeno za AVX: SSE
+// instrukcije dok su gornje polovine YMM registara zauzete su na Intel procesorima visestruko sporije. Na izlazu
+// prevodilac dodaje vzeroupper.
+BOIDS_TARGET_AVX2 static void accumulateAvx2(const BoidsFish& fish, const int ranges[3][2], int rangeCount, float px,
+    float py, const BoidsParameters& parameters, BoidsSums& sums)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    const __m256 radius2 = _mm256_set1_ps(parameters.neighborRadius * parameters.neighborRadius);
+    const __m256 separation2 = _mm256_set1_ps(parameters.separationRadius * parameters.separationRadius);
+    const __m256 inverseSeparation = _mm256_set1_ps(1.0f / parameters.separationRadius);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 x = _mm256_set1_ps(px), y = _mm256_set1_ps(py);
+    __m256 separationX = zero, separationY = zero, dirX = zero, dirY = zero, offsetX = zero, offsetY = zero;
+    __m256 neighbors = zero;
+    for (int r = 0; r < rangeCount; r++)
+        for (int j = ranges[r][0]; j < ranges[r][1]; j += 8)
+        {
+            __m256 inRange = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(ranges[r][1] - j), lanes));
+            __m256 dx = _mm256_sub_ps(x, _mm256_loadu_ps(&fish.x[j]));
+            __m256 dy = _mm256_sub_ps(y, _mm256_loadu_ps(&fish.y[j]));
+            __m256 distance2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 inRadius = _mm256_and_ps(inRange, _mm256_and_ps(_mm256_cmp_ps(distance2, zero, _CMP_GT_OQ),
+                _mm256_cmp_ps(distance2, radius2, _CMP_LT_OQ)));
+            if (_mm256_movemask_ps(inRadius) == 0) continue;
+            dirX = _mm256_add_ps(dirX, _mm256_and_ps(inRadius, _mm256_loadu_ps(&fish.dirX[j])));
+            dirY = _mm256_add_ps(dirY, _mm256_and_ps(inRadius, _mm256_loadu_ps(&fish.dirY[j])));
+            offsetX = _mm256_sub_ps(offsetX, _mm256_and_ps(inRadius, dx));
+            offsetY = _mm256_sub_ps(offsetY, _mm256_and_ps(inRadius, dy));
+            neighbors = _mm256_add_ps(neighbors, _mm256_and_ps(inRadius, one));
+            __m256 tooClose = _mm256_and_ps(inRadius, _mm256_cmp_ps(distance2, separation2, _CMP_LT_OQ));
+            if (_mm256_movemask_ps(tooClose) == 0) continue;
+            __m256 inverse = _mm256_rsqrt_ps(distance2);
+            inverse = _mm256_mul_ps(inverse, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, distance2),
+                _mm256_mul_ps(inverse, inverse))));
+            __m256 weight = _mm256_sub_ps(inverse, inverseSeparation);
+            separationX = _mm256_add_ps(separationX, _mm256_and_ps(tooClose, _mm256_mul_ps(dx, weight)));
+            separationY = _mm256_add_ps(separationY, _mm256_and_ps(tooClose, _mm256_mul_ps(dy, weight)));
+        }
+    sums.separationX += sum8(separationX);
+    sums.separationY += sum8(separationY);
+    sums.dirX += sum8(dirX);
+    sums.dirY += sum8(dirY);
+    sums.offsetX += sum8(offsetX);
+    sums.offsetY += sum8(offsetY);
+    sums.count += sum8(neighbors);
+}
+#endif
+
+static void steerSorted(const BoidsFish& fish, const SpatialGrid& grid, int count, const BoidsParameters& parameters,
+    AccumulateFunction accumulate, float* steerX, float* steerY)
+{
+    for (int s = 0; s < count; s++)
+    {
+        int ranges[3][2];
+        int rangeCount = grid.getNeighborRanges(fish.x[s], fish.y[s], ranges);
+        BoidsSums sums;
+        accumulate(fish, ranges, rangeCount, fish.x[s], fish.y[s], parameters, sums);
+        finishSteer(sums, fish.dirX[s], fish.dirY[s], parameters, steerX[s], steerY[s]);
+    }
+}
+
+void Boids::setKernel(BoidsKernel newKernel)
+{
+    kernel = isBoidsKernelSupported(newKernel) ? newKernel : BoidsKernel::Scalar;
+}
+
+void Boids::update(const BoidsFish& fish, float minX, float minY, float maxX, float maxY, const BoidsParameters& parameters)
+{
+    int count = (int)fish.size();
+    grid.build(fish.x.data(), fish.y.data(), count, minX, minY, maxX, maxY, parameters.neighborRadius);
+    const std::vector<int>& order = grid.getOrder();
+    sorted.resize(count + SIMD_PADDING);
+    for (int s = 0; s < count; s++)
+    {
+        int i = order[s];
+        sorted.x[s] = fish.x[i];
+        sorted.y[s] = fish.y[i];
+        sorted.dirX[s] = fish.dirX[i];
+        sorted.dirY[s] = fish.dirY[i];
+    }
+
+    sortedSteerX.resize(count);
+    sortedSteerY.resize(count);
+    AccumulateFunction accumulate = accumulateScalar;
+#ifdef BOIDS_USE_AVX2
+    if (kernel == BoidsKernel::Avx2) accumulate = accumulateAvx2;
+#endif
+#ifdef BOIDS_USE_SSE2
+    if (kernel == BoidsKernel::Sse2) accumulate = accumulateSse2;
+#endif
+    steerSorted(sorted, grid, count, parameters, accumulate, sortedSteerX.data(), sortedSteerY.data());
+
+    steerX.resize(count);
+    steerY.resize(count);
+    for (int s = 0; s < count; s++)
+    {
+        steerX[order[s]] = sortedSteerX[s];
+        steerY[order[s]] = sortedSteerY[s];
+    }
+}
+
+void computeBoidsNaive(const BoidsFish& fish, const BoidsParameters& parameters, std::vector<float>& steerX,
+    std::vector<float>& steerY)
+{
+    int count = (int)fish.size();
+    steerX.resize(count);
+    steerY.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        BoidsSums sums;
+        accumulateNeighbors(fish, 0, count, fish.x[i], fish.y[i], parameters, sums);
+        finishSteer(sums, fish.dirX[i], fish.dirY[i], parameters, steerX[i], steerY[i]);
+    }
+}
+
+// xorshift32, kao u simulaciji: isti brojevi na svim platformama
+static float benchRandom(unsigned& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state >> 8) * (1.0f / 16777216.0f);
+}
+
+static void randomSchool(BoidsFish& fish, int count, float side, unsigned& state)
+{
+    fish.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        fish.x[i] = benchRandom(state) * side;
+        fish.y[i] = benchRandom(state) * side;
+        float angle = benchRandom(state) * 6.2831853f;
+        fish.dirX[i] = std::cos(angle);
+        fish.dirY[i] = std::sin(angle);
+    }
+}
+
+bool checkBoidsKernel(BoidsKernel kernel, float tolerance)
+{
+    if (!isBoidsKernelSupported(kernel))
+    {
+        std::cout << "Jato: " << boidsKernelName(kernel) << " verzija nije podrzana na ovom procesoru" << std::endl;
+        return false;
+    }
+    const int count = 3001; //Nije djeljivo sa 8, pa svaka celija ima ostatak
+    const float side = 2.0f;
+    BoidsParameters parameters;
+    unsigned state = 2024;
+    BoidsFish fish;
+    randomSchool(fish, count, side, state);
+    for (int i = 0; i + 1 < count; i += 97)
+    {
+        //Ribe na istom mjestu, skoro na istom mjestu i van mreze
+        fish.x[i + 1] = fish.x[i];
+        fish.y[i + 1] = fish.y[i];
+    }
+    for (int i = 50; i + 1 < count; i += 101) fish.x[i + 1] = fish.x[i] + 1e-4f;
+    for (int i = 7; i < count; i += 89) fish.x[i] = i % 2 == 0 ? -0.1f : side + 0.1f;
+
+    Boids reference, tested;
+    reference.setKernel(BoidsKernel::Scalar);
+    tested.setKernel(kernel);
+    reference.update(fish, 0, 0, side, side, parameters);
+    tested.update(fish, 0, 0, side, side, parameters);
+    float worst = 0;
+    int worstFish = 0;
+    for (int i = 0; i < count; i++)
+    {
+        float x = reference.getSteerX()[i], y = reference.getSteerY()[i];
+        float difference = std::max(std::fabs(tested.getSteerX()[i] - x), std::fabs(tested.getSteerY()[i] - y));
+        float relative = difference / (1.0f + std::sqrt(x * x + y * y));
+        if (relative > worst)
+        {
+            worst = relative;
+            worstFish = i;
+        }
+    }
+    bool passed = worst <= tolerance;
+    std::cout << "Jato: " << boidsKernelName(kernel) << " prema skalarnoj, najveca razlika " << std::scientific
+        << std::setprecision(2) << worst << " (riba " << worstFish << "), granica " << tolerance << ": "
+        << (passed ? "u redu" : "NIJE U GRANICI") << std::defaultfloat << std::endl;
+    return passed;
+}
+
+bool checkBoidsKernels()
+{
+    bool passed = true;
+    const BoidsKernel kernels[] = { BoidsKernel::Sse2, BoidsKernel::Avx2 };
+    for (BoidsKernel kernel : kernels)
+        if (isBoidsKernelSupported(kernel) && !checkBoidsKernel(kernel)) passed = false;
+    return passed;
+}
+
+bool printBoidsBenchmark()
+{
+    const int counts[] = { 1000, 10000, 50000 };
+    const int naiveLimit = 10000; //Vise od ovoga O(n^2) traje sekundama
+    const float neighborsPerFish = 20.0f;
+    const BoidsKernel kernels[] = { BoidsKernel::Scalar, BoidsKernel::Sse2, BoidsKernel::Avx2 };
+    BoidsParameters parameters;
+
+    bool checked = checkBoidsKernels();
+
+    std::cout << "Jato: mreza + usmjeravanje, oko " << neighborsPerFish
+        << " susjeda po ribi (akvarijum raste sa brojem riba), najbolja verzija: " << boidsKernelName(getBestBoidsKernel())
+        << std::endl;
+    std::cout << std::left << std::setw(10) << "riba" << std::setw(12) << "verzija" << std::setw(12) << "ms"
+        << std::setw(14) << "ns po ribi" << "ubrzanje" << std::endl;
+
+    unsigned state = 12345;
+    for (int count : counts)
+    {
+        //Ista gustina za svaki broj riba, da se vidi kako posao raste sa brojem riba, a ne sa brojem susjeda
+        float side = std::sqrt(count * 3.14159265f * parameters.neighborRadius * parameters.neighborRadius / neighborsPerFish);
+        BoidsFish fish;
+        randomSchool(fish, count, side, state);
+
+        int repeats = std::max(3, 200000 / count);
+        double scalarMs = 0;
+        for (BoidsKernel kernel : kernels)
+        {
+            if (!isBoidsKernelSupported(kernel)) continue;
+            Boids boids;
+            boids.setKernel(kernel);
+            double bestMs = 1e30;
+            for (int r = 0; r < repeats; r++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                boids.update(fish, 0, 0, side, side, parameters);
+                auto stop = std::chrono::steady_clock::now();
+                bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(stop - start).count());
+            }
+            if (kernel == BoidsKernel::Scalar) scalarMs = bestMs;
+            std::cout << std::fixed << std::setprecision(3) << std::left << std::setw(10) << count
+                << std::setw(12) << boidsKernelName(kernel) << std::setw(12) << bestMs << std::setw(14)
+                << bestMs * 1.0e6 / count << scalarMs / bestMs << std::endl;
+        }
+        if (count <= naiveLimit)
+        {
+            std::vector<float> naiveX, naiveY;
+            auto start = std::chrono::steady_clock::now();
+            computeBoidsNaive(fish, parameters, naiveX, naiveY);
+            double naiveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << std::fixed << std::setprecision(3) << std::left << std::setw(10) << count << std::setw(12)
+                << "O(n^2)" << std::setw(12) << naiveMs << std::setw(14) << naiveMs * 1.0e6 / count
+                << scalarMs / naiveMs << std::endl;
+        }
+    }
+    if (!checked) std::cout << "Jato: SIMD verzija se ne slaze sa skalarnom" << std::endl;
+    return checked;
+}
@@ -0,0 +1,250 @@
+#include "../Header/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "../Header/GLStateCache.h"
+
+// Opis: crtanje u smanjenoj rezoluciji koja prati vrijeme frejma, i uvecanje u prozor
+
+static const double BUDGET_HEADROOM = 0.9; // Dio intervala frejma koji crtanje smije da potrosi
+static const double SMOOTHING = 0.1;
+static const double RAISE_THRESHOLD = 0.8; // Skala raste tek kad je vrijeme ispod ovog dijela budzeta
+static const float MAX_STEP_DOWN = 0.1f;
+static const float MAX_STEP_UP = 0.02f;
+static const float MIN_STEP = 0.01f;
+static const int SETTLE_FRAMES = DynamicResolution::FRAME_LATENCY + 2; // GPU vremena stizu sa zakasnjenjem
+
+DynamicResolutionOptions parseDynamicResolution(int argc, char** argv)
+{
+    DynamicResolutionOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--dynamic-res") options.enabled = true;
+        else if (argument == "--res-min" && i + 1 < argc) options.minScale = (float)std::atof(argv[++i]);
+        else if (argument == "--res-max" && i + 1 < argc) options.maxScale = (float)std::atof(argv[++i]);
+        else if (argument == "--res-fps" && i + 1 < argc) options.targetFps = std::atof(argv[++i]);
+        else if (argument == "--sharpen" && i + 1 < argc) options.sharpness = (float)std::atof(argv[++i]);
+    }
+    options.minScale = std::min(std::max(options.minScale, 0.25f), 1.0f);
+    options.maxScale = std::min(std::max(options.maxScale, options.minScale), 2.0f);
+    options.sharpness = std::min(std::max(options.sharpness, 0.0f), 1.0f);
+    if (options.targetFps < 0) options.targetFps = 0;
+    return options;
+}
+
+DynamicResolution::~DynamicResolution()
+{
+    destroy();
+}
+
+bool DynamicResolution::create(ShaderRegistry& shaderRegistry, const DynamicResolutionOptions& newOptions, double pacerFps)
+{
+    destroy();
+    options = newOptions;
+    double fps = options.targetFps > 0 ? options.targetFps : (pacerFps > 0 ? pacerFps : 60.0);
+    budgetMs = 1000.0 / fps * BUDGET_HEADROOM;
+    scale = std::min(options.maxScale, 1.0f);
+    lowestScale = scale;
+    smoothedSceneMs = 0;
+    smoothedUpscaleMs = 0;
+    framesSinceChange = 0;
+    frames = 0;
+    changes = 0;
+    scaleSum = 0;
+    frameMsSum = 0;
+
+    shaders = &shaderRegistry;
+    program = shaders->add("Shaders/upscale.vert", "Shaders/upscale.frag");
+    readUniformLocations();
+    //Temena se racunaju iz gl_VertexID, ali core profil ipak trazi vezan VAO
+    glGenVertexArrays(1, &vertexArray);
+    glGenQueries(FRAME_LATENCY * TIMESTAMP_COUNT, &queries[0][0]);
+    return shaders->getProgram(program) != 0;
+}
+
+void DynamicResolution::destroy()
+{
+    target.destroy();
+    if (vertexArray != 0) glState().deleteVertexArray(vertexArray);
+    vertexArray = 0;
+    if (queries[0][0] != 0) glDeleteQueries(FRAME_LATENCY * TIMESTAMP_COUNT, &queries[0][0]);
+    for (int i = 0; i < FRAME_LATENCY; i++)
+    {
+        for (int j = 0; j < TIMESTAMP_COUNT; j++) queries[i][j] = 0;
+        queryPending[i] = false;
+    }
+    outputWidth = outputHeight = 0;
+    shaders = nullptr;
+}
+
+void DynamicResolution::readUniformLocations()
+{
+    locationsReload = shaders->getReloadCount();
+    sourceLocation = shaders->getUniformLocation(program, "uSource");
+    uvScaleLocation = shaders->getUniformLocation(program, "uUvScale");
+    sharpnessLocation = shaders->getUniformLocation(program, "uSharpness");
+}
+
+void DynamicResolution::collectGpuTime()
+{
+    //Slot koji se sad ponovo koristi je poslat prije FRAME_LATENCY frejmova; ako ni tad nije gotov, mjerenje se odbacuje
+    if (!queryPending[currentQuery]) return;
+    queryPending[currentQuery] = false;
+    const GLuint* slot = queries[currentQuery];
+    GLint available = 0;
+    glGetQueryObjectiv(slot[FRAME_END], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+    GLuint64 times[TIMESTAMP_COUNT];
+    for (int i = 0; i < TIMESTAMP_COUNT; i++) glGetQueryObjectui64v(slot[i], GL_QUERY_RESULT, &times[i]);
+    gpuSceneMs = times[UPSCALE_BEGIN] > times[FRAME_BEGIN] ? (times[UPSCALE_BEGIN] - times[FRAME_BEGIN]) / 1.0e6 : 0.0;
+    if (queryUpscaled[currentQuery])
+        gpuUpscaleMs = times[FRAME_END] > times[UPSCALE_BEGIN] ? (times[FRAME_END] - times[UPSCALE_BEGIN]) / 1.0e6 : 0.0;
+}
+
+void DynamicResolution::beginFrame(GLuint framebuffer, int width, int height)
+{
+    outputFramebuffer = framebuffer;
+    outputWidth = width;
+    outputHeight = height;
+    frameStart = Clock::now();
+    collectGpuTime();
+    if (queries[currentQuery][FRAME_BEGIN] != 0) glQueryCounter(queries[currentQuery][FRAME_BEGIN], GL_TIMESTAMP);
+
+    direct = scale == 1.0f;
+    if (direct)
+    {
+        renderWidth = outputWidth;
+        renderHeight = outputHeight;
+        glState().bindFramebuffer(GL_FRAMEBUFFER, outputFramebuffer);
+        glState().viewport(0, 0, outputWidth, outputHeight);
+        return;
+    }
+
+    //Tekstura za najvecu skalu, pa promjena skale samo mijenja viewport
+    int targetWidth = std::max(1, (int)std::ceil(outputWidth * options.maxScale));
+    int targetHeight = std::max(1, (int)std::ceil(outputHeight * options.maxScale));
+    if (target.getWidth() != targetWidth || target.getHeight() != targetHeight) target.create(targetWidth, targetHeight);
+    renderWidth = std::min(std::max(1, (int)(outputWidth * scale + 0.5f)), target.getWidth());
+    renderHeight = std::min(std::max(1, (int)(outputHeight * scale + 0.5f)), target.getHeight());
+    target.bind();
+    glState().viewport(0, 0, renderWidth, renderHeight);
+    //glClear ne gleda viewport, pa scissor cuva ostatak teksture od nepotrebnog brisanja
+    glState().setEnabled(GL_SCISSOR_TEST, true);
+    glScissor(0, 0, renderWidth, renderHeight);
+}
+
+void DynamicResolution::endFrame()
+{
+    Clock::time_point upscaleStart = Clock::now();
+    GLuint* slot = queries[currentQuery];
+    if (slot[UPSCALE_BEGIN] != 0) glQueryCounter(slot[UPSCALE_BEGIN], GL_TIMESTAMP);
+    if (!direct)
+    {
+        glState().setEnabled(GL_SCISSOR_TEST, false);
+        glState().bindFramebuffer(GL_FRAMEBUFFER, outputFramebuffer);
+        glState().viewport(0, 0, outputWidth, outputHeight);
+        GLuint upscaleProgram = shaders != nullptr ? shaders->getProgram(program) : 0;
+        if (options.sharpness > 0 && upscaleProgram != 0)
+        {
+            //Posle ponovnog ucitavanja sejdera program je nov, pa i lokacije uniformi
+            if (shaders->getReloadCount() != locationsReload) readUniformLocations();
+            glState().useProgram(upscaleProgram);
+            glState().bindTextureUnit(0, GL_TEXTURE_2D, target.getTexture());
+            glUniform1i(sourceLocation, 0);
+            glUniform2f(uvScaleLocation, (float)renderWidth / target.getWidth(), (float)renderHeight / target.getHeight());
+            glUniform1f(sharpnessLocation, options.sharpness);
+            glState().setEnabled(GL_BLEND, false);
+            glState().bindVertexArray(vertexArray);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glState().setEnabled(GL_BLEND, true);
+        }
+        else
+        {
+            //Samo bilinearno uvecanje: glBlitFramebuffer ide kroz putanju drajvera, bez sejdera
+            glState().bindFramebuffer(GL_READ_FRAMEBUFFER, target.getFramebuffer());
+            glBlitFramebuffer(0, 0, renderWidth, renderHeight, 0, 0, outputWidth, outputHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        }
+    }
+    if (slot[FRAME_END] != 0)
+    {
+        glQueryCounter(slot[FRAME_END], GL_TIMESTAMP);
+        queryPending[currentQuery] = true;
+        queryUpscaled[currentQuery] = !direct;
+    }
+    currentQuery = (currentQuery + 1) % FRAME_LATENCY;
+
+    Clock::time_point end = Clock::now();
+    double cpuSceneMs = std::chrono::duration<double, std::milli>(upscaleStart - frameStart).count();
+    double cpuUpscaleMs = std::chrono::duration<double, std::milli>(end - upscaleStart).count();
+    updateScale(std::max(cpuSceneMs, gpuSceneMs), direct ? 0.0 : std::max(cpuUpscaleMs, gpuUpscaleMs));
+}
+
+double DynamicResolution::predictMs(float candidate) const
+{
+    //Scena kosta srazmjerno broju piksela (kvadratu skale), a uvecanje isto za svaku skalu osim pune
+    return smoothedSceneMs * candidate * candidate + (candidate != 1.0f ? smoothedUpscaleMs : 0.0);
+}
+
+void DynamicResolution::updateScale(double sceneMs, double upscaleMs)
+{
+    frames++;
+    frameMsSum += sceneMs + upscaleMs;
+    scaleSum += scale;
+    lowestScale = std::min(lowestScale, scale);
+
+    //Vrijeme scene se pamti svedeno na punu rezoluciju, pa promjena skale ne kvari prosjek
+    double fullSceneMs = sceneMs / ((double)scale * scale);
+    smoothedSceneMs = smoothedSceneMs > 0 ? smoothedSceneMs + (fullSceneMs - smoothedSceneMs) * SMOOTHING : fullSceneMs;
+    if (!direct) smoothedUpscaleMs = smoothedUpscaleMs > 0 ? smoothedUpscaleMs + (upscaleMs - smoothedUpscaleMs) * SMOOTHING : upscaleMs;
+    if (++framesSinceChange < SETTLE_FRAMES || smoothedSceneMs <= 0) return;
+
+    double current = predictMs(scale);
+    float next = scale;
+    if (current > budgetMs)
+    {
+        //Skala pri kojoj bi scena i uvecanje taman stali u budzet, ali ne vise od jednog koraka odjednom
+        double sceneBudget = budgetMs - smoothedUpscaleMs;
+        float wanted = sceneBudget > 0 ? (float)std::sqrt(sceneBudget / smoothedSceneMs) : options.minScale;
+        next = std::max(wanted, scale - MAX_STEP_DOWN);
+    }
+    else if (current < budgetMs * RAISE_THRESHOLD) next = scale + MAX_STEP_UP;
+    next = std::min(std::max(next, options.minScale), options.maxScale);
+
+    //Puna rezolucija nema uvecanje, pa se na nju prelazi cim je blizu ili cim bi bila jeftinija. Iznad pune (uz --res-max > 1)
+    //se ne vraca: crtanje u vecoj rezoluciji je uvijek skuplje, a bira se samo kad ima vremena, pa ostaje dok staje u budzet.
+    bool nativeAllowed = options.minScale <= 1.0f && options.maxScale >= 1.0f;
+    if (nativeAllowed && next < 1.0f && (1.0f - next < MAX_STEP_UP || predictMs(1.0f) <= predictMs(next))) next = 1.0f;
+    //Manja skala mora stvarno biti brza (na softverskom crtanju uvecanje moze da pojede ustedu), a veca ostati u budzetu
+    if (next < scale && predictMs(next) >= current) next = scale;
+    if (next > scale && predictMs(next) > budgetMs && predictMs(next) > current) next = scale;
+    if (next == scale || (std::fabs(next - scale) < MIN_STEP && next != 1.0f)) return;
+
+    scale = next;
+    framesSinceChange = 0;
+    changes++;
+}
+
+DynamicResolutionStats DynamicResolution::getStats() const
+{
+    DynamicResolutionStats stats;
+    stats.frames = frames;
+    stats.changes = changes;
+    stats.averageScale = frames > 0 ? scaleSum / frames : scale;
+    stats.minScale = lowestScale;
+    stats.averageFrameMs = frames > 0 ? frameMsSum / frames : 0;
+    stats.upscaleMs = smoothedUpscaleMs;
+    return stats;
+}
+
+void DynamicResolution::printReport() const
+{
+    DynamicResolutionStats stats = getStats();
+    std::cout << "Dinamicka rezolucija: " << stats.frames << " frejmova, skala prosjek " << stats.averageScale << " (najmanja "
+        << stats.minScale << ", sada " << scale << "), " << stats.changes << " promjena, vrijeme frejma " << stats.averageFrameMs
+        << " ms (uvecanje " << stats.upscaleMs << " ms), budzet " << budgetMs << " ms" << std::endl;
+}
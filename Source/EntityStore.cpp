@@ -0,0 +1,211 @@
+#include "../Header/EntityStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+// Opis: entiteti sa generacijama i poredjenje brzine azuriranja AoS i SoA rasporeda riba
+
+Entity EntityStore::create()
+{
+    Entity entity;
+    if (!freeIndices.empty())
+    {
+        entity.index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    else
+    {
+        entity.index = (unsigned)generations.size();
+        generations.push_back(0);
+    }
+    entity.generation = generations[entity.index];
+    alive++;
+    return entity;
+}
+
+void EntityStore::destroy(Entity entity)
+{
+    if (!isAlive(entity)) return;
+    for (ComponentPoolBase* pool : pools) pool->remove(entity);
+    //Nova generacija ponistava sve postojece oznake ovog entiteta
+    generations[entity.index]++;
+    freeIndices.push_back(entity.index);
+    alive--;
+}
+
+bool EntityStore::isAlive(Entity entity) const
+{
+    return entity.index < generations.size() && generations[entity.index] == entity.generation;
+}
+
+void EntityStore::clear()
+{
+    generations.clear();
+    freeIndices.clear();
+    alive = 0;
+}
+
+// Isti posao u sva tri rasporeda: kretanje sa odbijanjem od zidova i mahanje repom. Polja koja azuriranje ne
+// cita (boja, velicina, glad...) su tu kao u pravoj ribi; u AoS rasporedu se ucitavaju u kes zajedno sa ostalim.
+static const float BENCH_DT = 1.0f / 60.0f;
+
+static void bounce(float& x, float& y, float& vx, float& vy)
+{
+    if (x < -1.0f || x > 1.0f)
+    {
+        vx = -vx;
+        x = x < -1.0f ? -1.0f : 1.0f;
+    }
+    if (y < -1.0f || y > 1.0f)
+    {
+        vy = -vy;
+        y = y < -1.0f ? -1.0f : 1.0f;
+    }
+}
+
+static void animate(float& phase, float rate)
+{
+    phase += rate * BENCH_DT;
+    if (phase > 6.2831853f) phase -= 6.2831853f;
+}
+
+struct BenchFish {
+    float x, y, vx, vy;
+    float phase, rate;
+    float size, color[3], hunger, heading;
+    unsigned species, flags;
+    Entity target;
+};
+
+class BenchFishObject {
+public:
+    virtual ~BenchFishObject() = default;
+    virtual void update()
+    {
+        fish.x += fish.vx * BENCH_DT;
+        fish.y += fish.vy * BENCH_DT;
+        bounce(fish.x, fish.y, fish.vx, fish.vy);
+        animate(fish.phase, fish.rate);
+    }
+    BenchFish fish;
+};
+
+struct BenchPosition {
+    float x, y;
+};
+
+struct BenchVelocity {
+    float x, y;
+};
+
+struct BenchAnimation {
+    float phase, rate;
+};
+
+struct BenchAppearance {
+    float size, color[3], hunger, heading;
+    unsigned species, flags;
+    Entity target;
+};
+
+static BenchFish makeBenchFish(unsigned i)
+{
+    //Deterministicki raspored bez generatora, isti za sva tri rasporeda
+    BenchFish fish = {};
+    fish.x = ((i * 7919u) % 2000u) / 1000.0f - 1.0f;
+    fish.y = ((i * 104729u) % 2000u) / 1000.0f - 1.0f;
+    fish.vx = ((i * 31u) % 100u) / 100.0f - 0.5f;
+    fish.vy = ((i * 57u) % 100u) / 100.0f - 0.5f;
+    fish.rate = 6.0f + (i % 10u);
+    fish.size = 1.0f;
+    return fish;
+}
+
+template <typename Function>
+static double bestNsPerFish(int count, int repeats, Function update)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        update();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    return best / count;
+}
+
+void printEntityStoreBenchmark()
+{
+    const int counts[] = { 1000, 10000, 100000, 1000000 };
+    std::cout << "Azuriranje riba (kretanje i animacija), ns po ribi, najbolje od vise ponavljanja" << std::endl;
+    std::cout << std::left << std::setw(10) << "riba" << std::setw(14) << "objekti" << std::setw(14) << "AoS"
+        << std::setw(14) << "ECS (SoA)" << "ECS / AoS" << std::endl;
+
+    float checksum = 0;
+    for (int count : counts)
+    {
+        int repeats = std::max(5, 20000000 / count);
+
+        //Polimorfni objekti, svaki u svojoj alokaciji, obilaze se izmijesanim redom (kao posle dugog rada programa)
+        std::vector<std::unique_ptr<BenchFishObject>> objects(count);
+        for (int i = 0; i < count; i++)
+        {
+            objects[i].reset(new BenchFishObject());
+            objects[i]->fish = makeBenchFish((unsigned)i);
+        }
+        for (int i = count - 1; i > 0; i--) std::swap(objects[i], objects[(unsigned)i * 2654435761u % (unsigned)(i + 1)]);
+
+        std::vector<BenchFish> structs(count);
+        for (int i = 0; i < count; i++) structs[i] = makeBenchFish((unsigned)i);
+
+        EntityStore store;
+        ComponentPool<BenchPosition> positions;
+        ComponentPool<BenchVelocity> velocities;
+        ComponentPool<BenchAnimation> animations;
+        ComponentPool<BenchAppearance> appearances;
+        store.registerPool(positions);
+        store.registerPool(velocities);
+        store.registerPool(animations);
+        store.registerPool(appearances);
+        for (int i = 0; i < count; i++)
+        {
+            BenchFish fish = makeBenchFish((unsigned)i);
+            Entity entity = store.create();
+            positions.add(entity, { fish.x, fish.y });
+            velocities.add(entity, { fish.vx, fish.vy });
+            animations.add(entity, { fish.phase, fish.rate });
+            appearances.add(entity, { fish.size, { 0, 0, 0 }, fish.hunger, fish.heading, fish.species, fish.flags, fish.target });
+        }
+
+        double objectNs = bestNsPerFish(count, repeats, [&]() {
+            for (std::unique_ptr<BenchFishObject>& object : objects) object->update();
+        });
+        double structNs = bestNsPerFish(count, repeats, [&]() {
+            for (BenchFish& fish : structs)
+            {
+                fish.x += fish.vx * BENCH_DT;
+                fish.y += fish.vy * BENCH_DT;
+                bounce(fish.x, fish.y, fish.vx, fish.vy);
+                animate(fish.phase, fish.rate);
+            }
+        });
+        double entityNs = bestNsPerFish(count, repeats, [&]() {
+            forEach(velocities, positions, [](Entity, BenchVelocity& velocity, BenchPosition& position) {
+                position.x += velocity.x * BENCH_DT;
+                position.y += velocity.y * BENCH_DT;
+                bounce(position.x, position.y, velocity.x, velocity.y);
+            });
+            forEach(animations, [](Entity, BenchAnimation& animation) { animate(animation.phase, animation.rate); });
+        });
+        checksum += objects[0]->fish.x + structs[0].x + positions.at(0).x;
+
+        std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(10) << count << std::setw(14) << objectNs
+            << std::setw(14) << structNs << std::setw(14) << entityNs << entityNs / structNs << std::endl;
+    }
+    //Da kompajler ne izbaci petlje ciji rezultat niko ne cita
+    if (checksum == 12345.0f) std::cout << checksum << std::endl;
+}
@@ -0,0 +1,117 @@
+#include "../Header/FileWatcher.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Opis: pracenje izmjena fajlova (inotify na Linux-u, inace poredjenje vremena izmjene)
+
+namespace fs = std::filesystem;
+
+static const double SCAN_INTERVAL = 0.5; // Sekundi izmedju dva poredjenja vremena izmjene
+
+static fs::path normalizedPath(const std::string& filePath)
+{
+    std::error_code error;
+    fs::path absolute = fs::absolute(filePath, error);
+    return (error ? fs::path(filePath) : absolute).lexically_normal();
+}
+
+static fs::file_time_type lastWriteTime(const fs::path& path)
+{
+    std::error_code error;
+    fs::file_time_type time = fs::last_write_time(path, error);
+    return error ? fs::file_time_type::min() : time;
+}
+
+FileWatcher::FileWatcher()
+{
+#ifdef __linux__
+    inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (inotifyDescriptor >= 0) close(inotifyDescriptor);
+#endif
+}
+
+bool FileWatcher::isNative() const
+{
+#ifdef __linux__
+    return inotifyDescriptor >= 0;
+#else
+    return false;
+#endif
+}
+
+void FileWatcher::watch(const std::string& filePath)
+{
+    WatchedFile file;
+    file.path = filePath;
+    file.normalized = normalizedPath(filePath);
+    for (const WatchedFile& watched : files)
+        if (watched.normalized == file.normalized) return;
+    file.lastWrite = lastWriteTime(file.normalized);
+    files.push_back(file);
+
+#ifdef __linux__
+    if (inotifyDescriptor < 0) return;
+    //Prati se folder, ne fajl: snimanje preko preimenovanja zamijeni fajl pa bi pracenje samog fajla prestalo
+    fs::path directory = file.normalized.parent_path();
+    int descriptor = inotify_add_watch(inotifyDescriptor, directory.string().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (descriptor >= 0) directories[descriptor] = directory;
+#endif
+}
+
+std::vector<std::string> FileWatcher::poll()
+{
+    std::vector<std::string> changed;
+    auto markChanged = [&](const fs::path& path) {
+        for (WatchedFile& file : files)
+        {
+            if (file.normalized != path) continue;
+            file.lastWrite = lastWriteTime(file.normalized);
+            if (std::find(changed.begin(), changed.end(), file.path) == changed.end()) changed.push_back(file.path);
+        }
+    };
+
+#ifdef __linux__
+    if (inotifyDescriptor >= 0)
+    {
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(inotifyDescriptor, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* cursor = buffer; cursor < buffer + length;)
+            {
+                const inotify_event* event = (const inotify_event*)cursor;
+                auto directory = directories.find(event->wd);
+                if (directory != directories.end() && event->len > 0) markChanged(directory->second / event->name);
+                cursor += sizeof(inotify_event) + event->len;
+            }
+        }
+        return changed;
+    }
+#endif
+
+    double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (now - lastScan < SCAN_INTERVAL) return changed;
+    lastScan = now;
+    for (WatchedFile& file : files)
+    {
+        fs::file_time_type time = lastWriteTime(file.normalized);
+        if (time != file.lastWrite)
+        {
+            file.lastWrite = time;
+            changed.push_back(file.path);
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,141 @@
+#include "../Header/FishRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../Header/GLStateCache.h"
+
+// Opis: crtanje riba iz interpoliranog stanja simulacije
+
+static const int FISH_FLOATS_PER_VERTEX = 8; // x, y, r, g, b, a, u, v
+static const int FISH_VERTICES = 6; // Tijelo i rep, po jedan trougao
+//Koordinate teksture temena ribe: u ide od kraja repa do nosa, v preko sirine ribe
+static const float FISH_UV[FISH_VERTICES][2] = {
+    { 1.0f, 0.5f }, { 0.27f, 1.0f }, { 0.27f, 0.0f }, { 0.27f, 0.5f }, { 0.0f, 0.94f }, { 0.0f, 0.06f },
+};
+static const float FISH_LENGTH = 0.03f;
+static const float FOOD_SIZE = 0.006f;
+
+bool FishRenderer::create(ShaderRegistry& shaderRegistry, int fishCount)
+{
+    shaders = &shaderRegistry;
+    maxFish = fishCount;
+    //Obje varijante se prave odmah: niti dodatnih prozora crtaju posle ShaderRegistry::freeze, kad add vise ne radi
+    variants.reset(new ShaderVariants(shaderRegistry, "Shaders/fish.vert", "Shaders/fish.frag", { "TEXTURED" }));
+    program = variants->getHandle(0);
+    texturedProgram = variants->getHandle(TEXTURED);
+    bindSamplers();
+    if (!vertices.create(GL_ARRAY_BUFFER, (maxFish + AQUARIUM_MAX_FOOD) * FISH_VERTICES * FISH_FLOATS_PER_VERTEX * sizeof(float))) return false;
+
+    glGenVertexArrays(1, &vertexArray);
+    glState().bindVertexArray(vertexArray);
+    glState().bindBuffer(GL_ARRAY_BUFFER, vertices.getBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, FISH_FLOATS_PER_VERTEX * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, FISH_FLOATS_PER_VERTEX * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, FISH_FLOATS_PER_VERTEX * sizeof(float), (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glState().bindVertexArray(0);
+    return true;
+}
+
+void FishRenderer::bindSamplers()
+{
+    //Program dijele svi konteksti, a niti prozora crtaju istovremeno, pa se uniforme postavljaju samo ovdje (pri
+    //pravljenju i posle ponovnog ucitavanja, koje sa vise prozora ne radi), nikad pri crtanju
+    locationsReload = shaders->getReloadCount();
+    unsigned texturedId = shaders->getProgram(texturedProgram);
+    if (texturedId == 0) return;
+    glState().useProgram(texturedId);
+    glUniform1i(shaders->getUniformLocation(texturedProgram, "uTexture"), 0);
+}
+
+void FishRenderer::destroy()
+{
+    vertices.destroy();
+    glState().deleteVertexArray(vertexArray);
+    vertexArray = 0;
+    variants.reset();
+    shaders = nullptr;
+}
+
+void FishRenderer::draw(const std::vector<FishState>& fish, const std::vector<FoodState>& food)
+{
+    if (shaders == nullptr || shaders->getProgram(program) == 0 || (fish.empty() && food.empty())) return;
+    int count = std::min((int)fish.size(), maxFish);
+    int foodCount = std::min((int)food.size(), AQUARIUM_MAX_FOOD);
+
+    vertices.beginFrame();
+    size_t offset;
+    float* data = (float*)vertices.map((count + foodCount) * FISH_VERTICES * FISH_FLOATS_PER_VERTEX * sizeof(float),
+        FISH_FLOATS_PER_VERTEX * sizeof(float), offset); //Pomjeraj cijelog temena, da se moze dati kao prvo teme
+    if (data == nullptr)
+    {
+        //Svaki beginFrame ima svoj endFrame (fence particije), i kad se nista ne crta
+        vertices.endFrame();
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const FishState& f = fish[i];
+        float length = FISH_LENGTH * f.size;
+        float wag = std::sin(f.phase) * 0.35f * length;
+        //Oblik ribe u njenom koordinatnom sistemu (nos gleda u +x), pa rotacija za heading
+        const float shape[FISH_VERTICES][2] = {
+            { length, 0.0f }, { -0.6f * length, 0.4f * length }, { -0.6f * length, -0.4f * length },
+            { -0.6f * length, 0.0f }, { -1.2f * length, 0.35f * length + wag }, { -1.2f * length, -0.35f * length + wag },
+        };
+        float c = std::cos(f.heading), s = std::sin(f.heading);
+        for (int v = 0; v < FISH_VERTICES; v++)
+        {
+            float* vertex = data + (i * FISH_VERTICES + v) * FISH_FLOATS_PER_VERTEX;
+            vertex[0] = f.x + shape[v][0] * c - shape[v][1] * s;
+            vertex[1] = f.y + shape[v][0] * s + shape[v][1] * c;
+            vertex[2] = f.color[0];
+            vertex[3] = f.color[1];
+            vertex[4] = f.color[2];
+            vertex[5] = 1.0f;
+            vertex[6] = FISH_UV[v][0];
+            vertex[7] = FISH_UV[v][1];
+        }
+    }
+    for (int i = 0; i < foodCount; i++)
+    {
+        const float corners[FISH_VERTICES][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, -1 }, { 1, 1 }, { -1, 1 } };
+        for (int v = 0; v < FISH_VERTICES; v++)
+        {
+            float* vertex = data + ((count + i) * FISH_VERTICES + v) * FISH_FLOATS_PER_VERTEX;
+            vertex[0] = food[i].x + corners[v][0] * FOOD_SIZE;
+            vertex[1] = food[i].y + corners[v][1] * FOOD_SIZE;
+            vertex[2] = 0.45f;
+            vertex[3] = 0.3f;
+            vertex[4] = 0.15f;
+            vertex[5] = 1.0f;
+            vertex[6] = 0.0f;
+            vertex[7] = 0.0f;
+        }
+    }
+    vertices.unmap();
+
+    GLint first = (GLint)(offset / (FISH_FLOATS_PER_VERTEX * sizeof(float)));
+    glState().bindVertexArray(vertexArray);
+    unsigned texturedId = shaders->getProgram(texturedProgram);
+    if (texture != 0 && texturedId != 0 && count > 0)
+    {
+        //Posle ponovnog ucitavanja sejdera program je nov, sa podrazumijevanim vrijednostima uniformi
+        if (shaders->getReloadCount() != locationsReload) bindSamplers();
+        glState().useProgram(texturedId);
+        glState().bindTextureUnit(0, GL_TEXTURE_2D, texture);
+        glDrawArrays(GL_TRIANGLES, first, count * FISH_VERTICES);
+        first += count * FISH_VERTICES;
+        count = 0;
+    }
+    if (count + foodCount > 0)
+    {
+        glState().useProgram(shaders->getProgram(program));
+        glDrawArrays(GL_TRIANGLES, first, (count + foodCount) * FISH_VERTICES);
+    }
+    vertices.endFrame();
+}
@@ -0,0 +1,186 @@
+#include "../Header/FramePacer.h"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// Opis: poravnavanje frejmova sa ekranom (vsync, adaptivni vsync, ogranicenje fps, niska latencija) i vremena frejmova
+
+static const size_t FRAME_HISTORY = 2000;
+static const double LOW_LATENCY_MARGIN = 0.001; // Rezerva prije osvjezavanja, za nepredvidjene skokove
+
+void FramePacer::init(FramePacingMode pacingMode, double targetFps)
+{
+    mode = pacingMode;
+    double refreshRate = 60.0;
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* videoMode = monitor != nullptr ? glfwGetVideoMode(monitor) : nullptr;
+    if (videoMode != nullptr && videoMode->refreshRate > 0) refreshRate = videoMode->refreshRate;
+    targetInterval = 1.0 / (mode == FramePacingMode::Capped && targetFps > 0 ? targetFps : refreshRate);
+
+    int interval = 1;
+    if (mode == FramePacingMode::Capped || mode == FramePacingMode::Uncapped) interval = 0;
+    if (mode == FramePacingMode::Adaptive)
+    {
+        //Negativan interval je dozvoljen samo uz ekstenziju; bez nje je isto sto i obican vsync
+        if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear")) interval = -1;
+        else std::cout << "Adaptivni vsync nije podrzan, koristi se obican vsync" << std::endl;
+    }
+    glfwSwapInterval(interval);
+
+    frameTimes.assign(FRAME_HISTORY, 0.0f);
+    nextFrameTime = 0;
+    frames = 0;
+    missed = 0;
+    totalWork = 0;
+    workFrames = 0;
+    hasLastSwap = false;
+    hasSwapDeadline = false;
+    frameStart = Clock::now();
+}
+
+void FramePacer::preciseSleepUntil(Clock::time_point target)
+{
+    //Sleep moze da zakasni (rezolucija tajmera sistema), pa se spava do malo prije cilja, a ostatak se vrti
+    double remaining = std::chrono::duration<double>(target - Clock::now()).count();
+    if (remaining > sleepOvershoot)
+    {
+        Clock::time_point wake = target - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(sleepOvershoot));
+        std::this_thread::sleep_until(wake);
+        double overshoot = std::chrono::duration<double>(Clock::now() - wake).count();
+        if (overshoot > sleepOvershoot) sleepOvershoot = overshoot;
+        else sleepOvershoot = sleepOvershoot * 0.99 + overshoot * 0.01;
+        sleepOvershoot = std::min(std::max(sleepOvershoot, 0.0002), 0.004);
+    }
+    while (Clock::now() < target) std::this_thread::yield();
+}
+
+void FramePacer::waitForFrameStart()
+{
+    if (mode == FramePacingMode::LowLatency && hasLastSwap)
+    {
+        //Frejm pocinje tek toliko prije sledeceg osvjezavanja koliko mu treba, pa su ulaz i simulacija sto svjeziji
+        double lead = predictedWork + LOW_LATENCY_MARGIN;
+        if (lead < targetInterval)
+            preciseSleepUntil(lastSwap + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(targetInterval - lead)));
+    }
+    frameStart = Clock::now();
+}
+
+void FramePacer::beforeSwap()
+{
+    double work = std::chrono::duration<double>(Clock::now() - frameStart).count();
+    totalWork += work;
+    workFrames++;
+    //Procjena brzo raste (da se ne promasi osvjezavanje), a sporo opada
+    if (work > predictedWork) predictedWork = work;
+    else predictedWork = predictedWork * 0.95 + work * 0.05;
+
+    if (mode == FramePacingMode::Capped)
+    {
+        //Rok se pomjera za tacno jedan interval, pa se greska spavanja ne sabira iz frejma u frejm. Malo zakasnjenje
+        //se nadoknadi u sledecim frejmovima; tek kad se zakasni vise od intervala rok se ponovo racuna od sada.
+        Clock::duration interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(targetInterval));
+        Clock::time_point now = Clock::now();
+        if (!hasSwapDeadline || now - swapDeadline > interval) swapDeadline = now;
+        else preciseSleepUntil(swapDeadline);
+        swapDeadline += interval;
+        hasSwapDeadline = true;
+    }
+}
+
+void FramePacer::afterSwap()
+{
+    //Swap se obicno samo stavi u red; bez cekanja drajvera vrijeme swap-a ne bi odgovaralo osvjezavanju ekrana
+    if (mode == FramePacingMode::LowLatency) glFinish();
+
+    Clock::time_point now = Clock::now();
+    if (hasLastSwap)
+    {
+        double frameTime = std::chrono::duration<double>(now - lastSwap).count();
+        frameTimes[nextFrameTime] = (float)(frameTime * 1000.0);
+        nextFrameTime = (nextFrameTime + 1) % frameTimes.size();
+        frames++;
+        if (mode != FramePacingMode::Uncapped && frameTime > targetInterval * 1.5) missed++;
+    }
+    lastSwap = now;
+    hasLastSwap = true;
+}
+
+FrameTimeStats FramePacer::getStats() const
+{
+    FrameTimeStats stats;
+    stats.frames = frames;
+    stats.missed = missed;
+    size_t count = (size_t)std::min<unsigned long long>(frames, frameTimes.size());
+    if (count == 0) return stats;
+
+    std::vector<float> sorted(frameTimes.begin(), frameTimes.begin() + count);
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0, sumSquares = 0;
+    for (float time : sorted)
+    {
+        sum += time;
+        sumSquares += (double)time * time;
+    }
+    stats.averageMs = sum / count;
+    stats.jitterMs = std::sqrt(std::max(0.0, sumSquares / count - stats.averageMs * stats.averageMs));
+    stats.p50Ms = sorted[count / 2];
+    stats.p95Ms = sorted[std::min(count - 1, count * 95 / 100)];
+    stats.p99Ms = sorted[std::min(count - 1, count * 99 / 100)];
+    stats.maxMs = sorted.back();
+    stats.workMs = totalWork / std::max(workFrames, 1ULL) * 1000.0;
+    return stats;
+}
+
+void FramePacer::printReport() const
+{
+    FrameTimeStats stats = getStats();
+    std::cout << "Tempo frejmova (" << modeName(mode);
+    if (mode != FramePacingMode::Uncapped) std::cout << ", cilj " << 1.0 / targetInterval << " fps";
+    std::cout << "): " << stats.frames << " frejmova, prosjek " << stats.averageMs << " ms, p50 " << stats.p50Ms << ", p95 " << stats.p95Ms
+        << ", p99 " << stats.p99Ms << ", max " << stats.maxMs << ", odstupanje " << stats.jitterMs << " ms, rad "
+        << stats.workMs << " ms, zakasnjelih " << stats.missed << std::endl;
+}
+
+const char* FramePacer::modeName(FramePacingMode mode)
+{
+    switch (mode)
+    {
+    case FramePacingMode::Vsync: return "vsync";
+    case FramePacingMode::Adaptive: return "adaptive";
+    case FramePacingMode::Capped: return "cap";
+    case FramePacingMode::LowLatency: return "low-latency";
+    case FramePacingMode::Uncapped: return "uncapped";
+    }
+    return "?";
+}
+
+FramePacingMode parseFramePacing(int argc, char** argv, double& targetFps)
+{
+    FramePacingMode mode = FramePacingMode::Vsync;
+    targetFps = 60.0;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--no-vsync") mode = FramePacingMode::Uncapped;
+        else if (argument == "--fps-cap" && i + 1 < argc) targetFps = std::atof(argv[++i]);
+        else if (argument == "--pacing" && i + 1 < argc)
+        {
+            std::string name = argv[++i];
+            if (name == "vsync") mode = FramePacingMode::Vsync;
+            else if (name == "adaptive") mode = FramePacingMode::Adaptive;
+            else if (name == "cap") mode = FramePacingMode::Capped;
+            else if (name == "low-latency") mode = FramePacingMode::LowLatency;
+            else if (name == "uncapped") mode = FramePacingMode::Uncapped;
+            else std::cout << "Nepoznat nacin: " << name << " (vsync, adaptive, cap, low-latency, uncapped)" << std::endl;
+        }
+    }
+    if (targetFps <= 0) targetFps = 60.0;
+    return mode;
+}
@@ -0,0 +1,65 @@
+#include "../Header/FrameScheduler.h"
+
+#include <cstdlib>
+#include <string>
+
+// Opis: fiksni korak simulacije sa akumulatorom i zastitom od predugih frejmova
+
+FrameScheduler::FrameScheduler(double tickRate, int maxTicks, double maxFrame)
+    : tickSeconds(1.0 / (tickRate > 0 ? tickRate : 60.0)),
+      maxTicksPerFrame(maxTicks > 0 ? maxTicks : 1),
+      maxFrameSeconds(maxFrame)
+{
+}
+
+int FrameScheduler::advance(double frameSeconds)
+{
+    stats.frames++;
+    if (frameSeconds < 0) frameSeconds = 0; //Sat ne ide unazad, ali glfwSetTime moze da ga vrati
+    bool clamped = false;
+    if (frameSeconds > maxFrameSeconds)
+    {
+        stats.droppedSeconds += frameSeconds - maxFrameSeconds;
+        frameSeconds = maxFrameSeconds;
+        clamped = true;
+    }
+
+    accumulator += frameSeconds;
+    int ticks = 0;
+    while (accumulator >= tickSeconds && ticks < maxTicksPerFrame)
+    {
+        accumulator -= tickSeconds;
+        ticks++;
+    }
+    if (accumulator >= tickSeconds)
+    {
+        //Simulacija ne stize: ostatak se odbacuje, osim dijela za interpolaciju
+        double kept = accumulator - (long long)(accumulator / tickSeconds) * tickSeconds;
+        stats.droppedSeconds += accumulator - kept;
+        accumulator = kept;
+        clamped = true;
+    }
+
+    if (clamped) stats.clampedFrames++;
+    stats.ticks += ticks;
+    if (ticks > stats.maxTicksInFrame) stats.maxTicksInFrame = ticks;
+    return ticks;
+}
+
+int FrameScheduler::advanceTo(double now)
+{
+    double elapsed = lastTime < 0 ? 0 : now - lastTime;
+    lastTime = now;
+    return advance(elapsed);
+}
+
+double parseTickRate(int argc, char** argv, double defaultRate)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::string(argv[i]) != "--tick-rate") continue;
+        double rate = std::atof(argv[i + 1]);
+        if (rate > 0) return rate;
+    }
+    return defaultRate;
+}
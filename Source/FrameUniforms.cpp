@@ -0,0 +1,43 @@
+#include "../Header/FrameUniforms.h"
+
+#include <cstring>
+
+#include "../Header/GLStateCache.h"
+
+// Opis: zajednicki uniform bafer sa podacima frejma (matrica, vrijeme, parametri vode)
+
+bool FrameUniforms::create()
+{
+    GLint offsetAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    if (offsetAlignment > 0) alignment = (size_t)offsetAlignment;
+    //Jedan blok po particiji; vise mjesta nije potrebno jer se update poziva jednom po frejmu
+    size_t blockSize = (sizeof(FrameUniformData) + alignment - 1) / alignment * alignment;
+    return buffer.create(GL_UNIFORM_BUFFER, blockSize);
+}
+
+void FrameUniforms::destroy()
+{
+    buffer.destroy();
+}
+
+void FrameUniforms::update(const FrameUniformData& data)
+{
+    buffer.beginFrame();
+    size_t offset;
+    void* destination = buffer.map(sizeof(FrameUniformData), alignment, offset);
+    if (destination == nullptr) return;
+    memcpy(destination, &data, sizeof(FrameUniformData));
+    buffer.unmap();
+    glState().bindBufferRange(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, buffer.getBuffer(), (GLintptr)offset, sizeof(FrameUniformData));
+}
+
+void FrameUniforms::endFrame()
+{
+    buffer.endFrame();
+}
+
+void setIdentityMatrix(float matrix[16])
+{
+    for (int i = 0; i < 16; i++) matrix[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+}
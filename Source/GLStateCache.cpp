@@ -0,0 +1,289 @@
+#include "../Header/GLStateCache.h"
+
+// Opis: kes OpenGL stanja koji preskace suvisne bind/use/enable pozive i broji ih po frejmu
+
+static GLStateCache defaultState;
+static thread_local GLStateCache* currentState = &defaultState;
+
+GLStateCache& glState()
+{
+    return *currentState;
+}
+
+void setCurrentGLState(GLStateCache* state)
+{
+    currentState = state != nullptr ? state : &defaultState;
+}
+
+GLStateCache::GLStateCache()
+{
+    invalidate();
+}
+
+void GLStateCache::invalidate()
+{
+    program = UNKNOWN;
+    activeUnit = UNKNOWN;
+    for (int unit = 0; unit < MAX_TEXTURE_UNITS; unit++)
+        for (int target = 0; target < TEXTURE_TARGET_COUNT; target++)
+            textures[unit][target] = UNKNOWN;
+    vertexArray = UNKNOWN;
+    for (int target = 0; target < BUFFER_TARGET_COUNT; target++) buffers[target] = UNKNOWN;
+    for (int index = 0; index < MAX_UNIFORM_BUFFER_BINDINGS; index++) uniformBufferBindings[index] = UNKNOWN;
+    drawFramebuffer = UNKNOWN;
+    readFramebuffer = UNKNOWN;
+    viewportRect[0] = viewportRect[1] = viewportRect[2] = viewportRect[3] = -1;
+    for (int capability = 0; capability < CAPABILITY_COUNT; capability++) capabilities[capability] = UNKNOWN;
+    blendSource = blendDestination = UNKNOWN;
+    depthFunction = UNKNOWN;
+    depthWrite = UNKNOWN;
+}
+
+void GLStateCache::beginFrame()
+{
+    lastFrame = currentFrame;
+    currentFrame = GLStateCounters();
+}
+
+int GLStateCache::textureTargetIndex(GLenum target)
+{
+    switch (target) {
+    case GL_TEXTURE_2D: return TEXTURE_2D;
+    case GL_TEXTURE_2D_ARRAY: return TEXTURE_2D_ARRAY;
+    case GL_TEXTURE_CUBE_MAP: return TEXTURE_CUBE_MAP;
+    default: return -1;
+    }
+}
+
+int GLStateCache::bufferTargetIndex(GLenum target)
+{
+    switch (target) {
+    case GL_ARRAY_BUFFER: return ARRAY_BUFFER;
+    case GL_ELEMENT_ARRAY_BUFFER: return ELEMENT_ARRAY_BUFFER;
+    case GL_UNIFORM_BUFFER: return UNIFORM_BUFFER;
+    case GL_PIXEL_UNPACK_BUFFER: return PIXEL_UNPACK_BUFFER;
+    case GL_PIXEL_PACK_BUFFER: return PIXEL_PACK_BUFFER;
+    default: return -1;
+    }
+}
+
+int GLStateCache::capabilityIndex(GLenum capability)
+{
+    switch (capability) {
+    case GL_BLEND: return BLEND;
+    case GL_DEPTH_TEST: return DEPTH_TEST;
+    case GL_CULL_FACE: return CULL_FACE;
+    case GL_SCISSOR_TEST: return SCISSOR_TEST;
+    case GL_STENCIL_TEST: return STENCIL_TEST;
+    default: return -1;
+    }
+}
+
+bool GLStateCache::change(GLuint& cached, GLuint value)
+{
+    if (cached == value)
+    {
+        countSkipped();
+        return false;
+    }
+    cached = value;
+    countIssued();
+    return true;
+}
+
+void GLStateCache::useProgram(GLuint newProgram)
+{
+    if (change(program, newProgram)) glUseProgram(newProgram);
+}
+
+void GLStateCache::activeTexture(GLuint unit)
+{
+    if (change(activeUnit, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLStateCache::bindTexture(GLenum target, GLuint texture)
+{
+    int targetIndex = textureTargetIndex(target);
+    if (targetIndex < 0 || activeUnit == UNKNOWN || activeUnit >= MAX_TEXTURE_UNITS)
+    {
+        //Ne pratimo ovu kombinaciju, pa samo prosledjujemo poziv
+        countIssued();
+        glBindTexture(target, texture);
+        if (targetIndex >= 0 && activeUnit == UNKNOWN)
+        {
+            for (int unit = 0; unit < MAX_TEXTURE_UNITS; unit++) textures[unit][targetIndex] = UNKNOWN;
+        }
+        return;
+    }
+    if (change(textures[activeUnit][targetIndex], texture)) glBindTexture(target, texture);
+}
+
+void GLStateCache::bindTextureUnit(GLuint unit, GLenum target, GLuint texture)
+{
+    int targetIndex = textureTargetIndex(target);
+    if (targetIndex >= 0 && unit < MAX_TEXTURE_UNITS && textures[unit][targetIndex] == texture)
+    {
+        //Tekstura je vec na toj jedinici, ne treba ni mijenjati aktivnu jedinicu
+        countSkipped();
+        return;
+    }
+    activeTexture(unit);
+    bindTexture(target, texture);
+}
+
+void GLStateCache::bindVertexArray(GLuint newVertexArray)
+{
+    if (change(vertexArray, newVertexArray))
+    {
+        glBindVertexArray(newVertexArray);
+        buffers[ELEMENT_ARRAY_BUFFER] = UNKNOWN; //Indeksni bafer je dio stanja VAO-a
+    }
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    int targetIndex = bufferTargetIndex(target);
+    if (targetIndex < 0)
+    {
+        countIssued();
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (change(buffers[targetIndex], buffer)) glBindBuffer(target, buffer);
+}
+
+void GLStateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    if (target != GL_UNIFORM_BUFFER || index >= MAX_UNIFORM_BUFFER_BINDINGS)
+    {
+        countIssued();
+        glBindBufferBase(target, index, buffer);
+        int targetIndex = bufferTargetIndex(target);
+        if (targetIndex >= 0) buffers[targetIndex] = buffer;
+        return;
+    }
+    if (change(uniformBufferBindings[index], buffer))
+    {
+        glBindBufferBase(target, index, buffer);
+        buffers[UNIFORM_BUFFER] = buffer; //glBindBufferBase mijenja i opste vezivanje
+    }
+}
+
+void GLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    //Opseg se obicno mijenja svaki frejm (prstenasti bafer), pa se ne poredi; pamti se samo da vezivanje nije poznato
+    countIssued();
+    glBindBufferRange(target, index, buffer, offset, size);
+    if (target == GL_UNIFORM_BUFFER && index < MAX_UNIFORM_BUFFER_BINDINGS) uniformBufferBindings[index] = UNKNOWN;
+    int targetIndex = bufferTargetIndex(target);
+    if (targetIndex >= 0) buffers[targetIndex] = buffer;
+}
+
+void GLStateCache::bindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+    if ((!draw || drawFramebuffer == framebuffer) && (!read || readFramebuffer == framebuffer))
+    {
+        countSkipped();
+        return;
+    }
+    countIssued();
+    glBindFramebuffer(target, framebuffer);
+    if (draw) drawFramebuffer = framebuffer;
+    if (read) readFramebuffer = framebuffer;
+}
+
+void GLStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if (viewportRect[0] == x && viewportRect[1] == y && viewportRect[2] == width && viewportRect[3] == height)
+    {
+        countSkipped();
+        return;
+    }
+    countIssued();
+    glViewport(x, y, width, height);
+    viewportRect[0] = x;
+    viewportRect[1] = y;
+    viewportRect[2] = width;
+    viewportRect[3] = height;
+}
+
+void GLStateCache::setEnabled(GLenum capability, bool enabled)
+{
+    int index = capabilityIndex(capability);
+    if (index >= 0 && !change(capabilities[index], enabled ? 1u : 0u)) return;
+    if (index < 0) countIssued();
+    if (enabled) glEnable(capability);
+    else glDisable(capability);
+}
+
+void GLStateCache::blendFunc(GLenum source, GLenum destination)
+{
+    if (blendSource == source && blendDestination == destination)
+    {
+        countSkipped();
+        return;
+    }
+    countIssued();
+    glBlendFunc(source, destination);
+    blendSource = source;
+    blendDestination = destination;
+}
+
+void GLStateCache::depthFunc(GLenum function)
+{
+    if (change(depthFunction, function)) glDepthFunc(function);
+}
+
+void GLStateCache::depthMask(GLboolean mask)
+{
+    if (change(depthWrite, mask)) glDepthMask(mask);
+}
+
+void GLStateCache::deleteTexture(GLuint texture)
+{
+    if (texture == 0) return;
+    glDeleteTextures(1, &texture);
+    //OpenGL sam odvezuje obrisanu teksturu sa svih jedinica
+    for (int unit = 0; unit < MAX_TEXTURE_UNITS; unit++)
+        for (int target = 0; target < TEXTURE_TARGET_COUNT; target++)
+            if (textures[unit][target] == texture) textures[unit][target] = 0;
+}
+
+void GLStateCache::deleteProgram(GLuint deletedProgram)
+{
+    if (deletedProgram == 0) return;
+    glDeleteProgram(deletedProgram);
+    //Program koji je u upotrebi ostaje vezan dok se ne zamijeni, ali njegovo ime se moze ponovo dodijeliti
+    if (program == deletedProgram) program = UNKNOWN;
+}
+
+void GLStateCache::deleteVertexArray(GLuint deletedVertexArray)
+{
+    if (deletedVertexArray == 0) return;
+    glDeleteVertexArrays(1, &deletedVertexArray);
+    if (vertexArray == deletedVertexArray)
+    {
+        vertexArray = 0;
+        buffers[ELEMENT_ARRAY_BUFFER] = UNKNOWN;
+    }
+}
+
+void GLStateCache::deleteBuffer(GLuint buffer)
+{
+    if (buffer == 0) return;
+    glDeleteBuffers(1, &buffer);
+    for (int target = 0; target < BUFFER_TARGET_COUNT; target++)
+        if (buffers[target] == buffer) buffers[target] = 0;
+    for (int index = 0; index < MAX_UNIFORM_BUFFER_BINDINGS; index++)
+        if (uniformBufferBindings[index] == buffer) uniformBufferBindings[index] = 0;
+}
+
+void GLStateCache::deleteFramebuffer(GLuint framebuffer)
+{
+    if (framebuffer == 0) return;
+    glDeleteFramebuffers(1, &framebuffer);
+    if (drawFramebuffer == framebuffer) drawFramebuffer = 0;
+    if (readFramebuffer == framebuffer) readFramebuffer = 0;
+}
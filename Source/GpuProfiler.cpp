@@ -0,0 +1,298 @@
+#include "../Header/GpuProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "../Header/GLStateCache.h"
+
+// Opis: mjerenje vremena prolaza na GPU bez zaustavljanja (timestamp upiti citani sa zakasnjenjem) i prikaz na ekranu
+
+GpuProfiler::~GpuProfiler()
+{
+    if (!allQueries.empty()) glDeleteQueries((GLsizei)allQueries.size(), allQueries.data());
+}
+
+GLuint GpuProfiler::acquireQuery()
+{
+    if (freeQueries.empty())
+    {
+        //Bazen raste samo dok se ne ustali broj prolaza po frejmu
+        GLuint created[16];
+        glGenQueries(16, created);
+        allQueries.insert(allQueries.end(), created, created + 16);
+        freeQueries.insert(freeQueries.end(), created, created + 16);
+    }
+    GLuint query = freeQueries.back();
+    freeQueries.pop_back();
+    return query;
+}
+
+int GpuProfiler::passIndex(const char* name)
+{
+    auto found = passIndices.find(name);
+    if (found != passIndices.end()) return found->second;
+
+    PassHistory history;
+    history.name = name;
+    history.samples.reserve(HISTORY_SIZE);
+    passes.push_back(history);
+    passIndices[name] = (int)passes.size() - 1;
+    return (int)passes.size() - 1;
+}
+
+void GpuProfiler::release(PendingFrame& frame)
+{
+    for (const PassQuery& query : frame.queries)
+    {
+        freeQueries.push_back(query.begin);
+        freeQueries.push_back(query.end);
+    }
+    frame.queries.clear();
+    frame.pending = false;
+}
+
+bool GpuProfiler::collect(PendingFrame& frame)
+{
+    if (!frame.pending) return true;
+    if (frame.queries.empty())
+    {
+        frame.pending = false;
+        return true;
+    }
+
+    //Timestamp upiti se zavrsavaju redom, pa je dovoljno provjeriti poslednji upisani (kraj prolaza "frame")
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(frame.queries.front().end, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) return false;
+
+    for (const PassQuery& query : frame.queries)
+    {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(query.begin, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end);
+        float ms = end > begin ? (float)((end - begin) / 1.0e6) : 0.0f;
+
+        PassHistory& history = passes[query.pass];
+        if (history.samples.size() < HISTORY_SIZE) history.samples.push_back(ms);
+        else history.samples[history.next] = ms;
+        history.next = (history.next + 1) % HISTORY_SIZE;
+        history.total++;
+        history.last = ms;
+    }
+    release(frame);
+    return true;
+}
+
+void GpuProfiler::beginFrame()
+{
+    //Pokupi rezultate svih frejmova koji su spremni, od najstarijeg
+    for (int i = 1; i <= FRAME_LATENCY; i++)
+    {
+        PendingFrame& frame = frames[(currentFrame + i) % FRAME_LATENCY];
+        if (!collect(frame)) break;
+    }
+
+    currentFrame = (currentFrame + 1) % FRAME_LATENCY;
+    PendingFrame& frame = frames[currentFrame];
+    if (frame.pending)
+    {
+        //GPU kasni vise od FRAME_LATENCY frejmova; radije odbacujemo mjerenje nego da cekamo
+        release(frame);
+        droppedFrames++;
+    }
+
+    inFrame = true;
+    openPasses.clear();
+    beginPass("frame");
+}
+
+void GpuProfiler::endFrame()
+{
+    if (!inFrame) return;
+    while (!openPasses.empty()) endPass();
+    frames[currentFrame].pending = true;
+    inFrame = false;
+}
+
+void GpuProfiler::beginPass(const char* name)
+{
+    if (!inFrame) return;
+    PassQuery query;
+    query.pass = passIndex(name);
+    query.begin = acquireQuery();
+    query.end = 0;
+    glQueryCounter(query.begin, GL_TIMESTAMP);
+    openPasses.push_back(frames[currentFrame].queries.size());
+    frames[currentFrame].queries.push_back(query);
+}
+
+void GpuProfiler::endPass()
+{
+    if (!inFrame || openPasses.empty()) return;
+    PassQuery& query = frames[currentFrame].queries[openPasses.back()];
+    openPasses.pop_back();
+    query.end = acquireQuery();
+    glQueryCounter(query.end, GL_TIMESTAMP);
+}
+
+std::vector<GpuPassStats> GpuProfiler::getStats() const
+{
+    std::vector<GpuPassStats> result;
+    std::vector<float> sorted;
+    for (const PassHistory& history : passes)
+    {
+        GpuPassStats stats;
+        stats.name = history.name;
+        stats.samples = history.total;
+        stats.lastMs = history.last;
+        if (!history.samples.empty())
+        {
+            sorted = history.samples;
+            std::sort(sorted.begin(), sorted.end());
+            double sum = 0;
+            for (float sample : sorted) sum += sample;
+            stats.averageMs = sum / sorted.size();
+            stats.p50Ms = sorted[(sorted.size() - 1) * 50 / 100];
+            stats.p95Ms = sorted[(sorted.size() - 1) * 95 / 100];
+            stats.p99Ms = sorted[(sorted.size() - 1) * 99 / 100];
+            stats.maxMs = sorted.back();
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+bool GpuProfiler::writeCsv(const char* filePath) const
+{
+    std::ofstream file(filePath);
+    if (!file.is_open()) return false;
+    file << "pass,samples,avg_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+    for (const GpuPassStats& stats : getStats())
+    {
+        file << stats.name << "," << stats.samples << "," << stats.averageMs << "," << stats.p50Ms << ","
+            << stats.p95Ms << "," << stats.p99Ms << "," << stats.maxMs << "\n";
+    }
+    return file.good();
+}
+
+bool GpuProfiler::writeJson(const char* filePath) const
+{
+    std::ofstream file(filePath);
+    if (!file.is_open()) return false;
+    file << "{\n  \"dropped_frames\": " << droppedFrames << ",\n  \"passes\": [";
+    std::vector<GpuPassStats> all = getStats();
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        const GpuPassStats& stats = all[i];
+        file << (i == 0 ? "\n" : ",\n") << "    { \"name\": \"" << stats.name << "\", \"samples\": " << stats.samples
+            << ", \"avg_ms\": " << stats.averageMs << ", \"p50_ms\": " << stats.p50Ms << ", \"p95_ms\": " << stats.p95Ms
+            << ", \"p99_ms\": " << stats.p99Ms << ", \"max_ms\": " << stats.maxMs << " }";
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+// ---------------------------------------------------------------- Prikaz na ekranu
+
+static const float OVERLAY_FRAME_MS = 1000.0f / 60.0f; // Puna sirina trake
+static const int OVERLAY_MAX_BARS = 16;
+static const int OVERLAY_FLOATS_PER_VERTEX = 6; // x, y, r, g, b, a
+
+bool GpuProfilerOverlay::create(ShaderRegistry& shaderRegistry)
+{
+    shaders = &shaderRegistry;
+    program = shaders->add("Shaders/overlay.vert", "Shaders/overlay.frag");
+    //Po dvije trake (prosjek i p95) za svaki prolaz, plus pozadina i oznaka budzeta, po 6 temena
+    size_t maxVertices = (OVERLAY_MAX_BARS * 2 + 2) * 6;
+    if (!vertices.create(GL_ARRAY_BUFFER, maxVertices * OVERLAY_FLOATS_PER_VERTEX * sizeof(float))) return false;
+
+    glGenVertexArrays(1, &vertexArray);
+    glState().bindVertexArray(vertexArray);
+    glState().bindBuffer(GL_ARRAY_BUFFER, vertices.getBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, OVERLAY_FLOATS_PER_VERTEX * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, OVERLAY_FLOATS_PER_VERTEX * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glState().bindVertexArray(0);
+    return true;
+}
+
+void GpuProfilerOverlay::destroy()
+{
+    vertices.destroy();
+    glState().deleteVertexArray(vertexArray);
+    vertexArray = 0;
+    shaders = nullptr;
+}
+
+static void addQuad(float* out, int& count, float x0, float y0, float x1, float y1, const float color[4])
+{
+    const float corners[6][2] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y0 }, { x1, y1 }, { x0, y1 } };
+    for (const auto& corner : corners)
+    {
+        float* vertex = out + count * OVERLAY_FLOATS_PER_VERTEX;
+        vertex[0] = corner[0];
+        vertex[1] = corner[1];
+        for (int c = 0; c < 4; c++) vertex[2 + c] = color[c];
+        count++;
+    }
+}
+
+void GpuProfilerOverlay::draw(const std::vector<GpuPassStats>& stats)
+{
+    if (shaders == nullptr || shaders->getProgram(program) == 0 || stats.empty()) return;
+    static const float COLORS[6][4] = {
+        { 1.0f, 1.0f, 1.0f, 0.9f }, { 1.0f, 0.6f, 0.2f, 0.9f }, { 0.3f, 0.7f, 1.0f, 0.9f },
+        { 1.0f, 0.9f, 0.2f, 0.9f }, { 0.6f, 1.0f, 0.4f, 0.9f }, { 1.0f, 0.4f, 0.8f, 0.9f },
+    };
+    const float background[4] = { 0.0f, 0.0f, 0.0f, 0.5f };
+    const float budget[4] = { 1.0f, 0.0f, 0.0f, 0.9f };
+    const float left = -0.95f, top = 0.95f, width = 0.9f, rowHeight = 0.03f, rowStep = 0.04f;
+
+    int bars = std::min((int)stats.size(), OVERLAY_MAX_BARS);
+    vertices.beginFrame();
+    size_t offset;
+    float* data = (float*)vertices.map((bars * 2 + 2) * 6 * OVERLAY_FLOATS_PER_VERTEX * sizeof(float), sizeof(float), offset);
+    if (data == nullptr)
+    {
+        vertices.endFrame(); //Svaki beginFrame ima svoj endFrame, i kad se nista ne crta
+        return;
+    }
+
+    int count = 0;
+    float bottom = top - bars * rowStep - 0.01f;
+    addQuad(data, count, left - 0.01f, bottom, left + width + 0.01f, top + 0.01f, background);
+    for (int i = 0; i < bars; i++)
+    {
+        float y1 = top - i * rowStep;
+        float y0 = y1 - rowHeight;
+        float average = std::min((float)stats[i].averageMs / OVERLAY_FRAME_MS, 1.0f) * width;
+        float p95 = std::min((float)stats[i].p95Ms / OVERLAY_FRAME_MS, 1.0f) * width;
+        addQuad(data, count, left, y0, left + average, y1, COLORS[i % 6]);
+        addQuad(data, count, left, y0, left + p95, y0 + rowHeight * 0.25f, COLORS[i % 6]);
+    }
+    addQuad(data, count, left + width - 0.003f, bottom, left + width, top + 0.01f, budget);
+    vertices.unmap();
+
+    glState().useProgram(shaders->getProgram(program));
+    glState().bindVertexArray(vertexArray);
+    glState().setEnabled(GL_BLEND, true);
+    glState().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLES, (GLint)(offset / (OVERLAY_FLOATS_PER_VERTEX * sizeof(float))), count);
+    vertices.endFrame();
+}
+
+std::string GpuProfilerOverlay::formatSummary(const std::vector<GpuPassStats>& stats)
+{
+    std::ostringstream text;
+    text.precision(2);
+    text << std::fixed;
+    for (size_t i = 0; i < stats.size(); i++)
+    {
+        if (i > 0) text << " | ";
+        text << stats[i].name << " " << stats[i].averageMs << " ms (p95 " << stats[i].p95Ms << ")";
+    }
+    return text.str();
+}
@@ -0,0 +1,57 @@
+#include "../Header/Headless.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+// Opis: opcije i prozor za crtanje bez ekrana
+
+HeadlessOptions parseHeadlessOptions(int argc, char** argv)
+{
+    HeadlessOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--headless") options.enabled = true;
+        else if (argument == "--frames" && i + 1 < argc) options.frames = std::atoi(argv[++i]);
+        else if (argument == "--dump" && i + 1 < argc) options.dumpPath = argv[++i];
+        else if (argument == "--size" && i + 1 < argc)
+        {
+            int width, height;
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) == 2 && width > 0 && height > 0)
+            {
+                options.width = width;
+                options.height = height;
+            }
+            else std::cout << "Velicina treba da bude u obliku 1920x1080: " << argv[i] << std::endl;
+        }
+    }
+    if (options.frames < 1) options.frames = 1;
+    return options;
+}
+
+static GLFWwindow* createInvisibleWindow()
+{
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    //Velicina prozora nije bitna, crta se u framebuffer
+    return glfwCreateWindow(64, 64, "Kostur", NULL, NULL);
+}
+
+GLFWwindow* createHeadlessWindow()
+{
+    if (glfwInit())
+    {
+        GLFWwindow* window = createInvisibleWindow();
+        if (window != NULL) return window;
+        glfwTerminate();
+    }
+
+    std::cout << "Nevidljiv prozor nije napravljen, pokusava se OSMesa bez ekrana" << std::endl;
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (!glfwInit()) return NULL;
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    return createInvisibleWindow();
+}
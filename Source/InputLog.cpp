@@ -0,0 +1,207 @@
+#include "../Header/InputLog.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+
+// Opis: snimanje dogadjaja sa ulaza po koracima simulacije i njihova reprodukcija
+
+static const char INPUT_LOG_MAGIC[4] = { 'K', 'I', 'N', 'P' };
+static const unsigned INPUT_LOG_VERSION = 1;
+
+struct InputLogHeader {
+    char magic[4];
+    unsigned version;
+    unsigned seed;
+    int fishCount;
+    double tickRate;
+    unsigned long long endTick;
+    unsigned long long eventCount;
+};
+
+static_assert(sizeof(InputLogHeader) == 40, "Zaglavlje snimka ulaza mora imati 40 bajtova");
+
+InputLogOptions parseInputLogOptions(int argc, char** argv)
+{
+    InputLogOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--record" && i + 1 < argc) options.recordPath = argv[++i];
+        else if (argument == "--replay" && i + 1 < argc) options.replayPath = argv[++i];
+        else if (argument == "--seed" && i + 1 < argc) options.seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+    }
+    if (!options.recordPath.empty() && !options.replayPath.empty())
+    {
+        std::cout << "Snimanje i reprodukcija ne mogu zajedno, snima se samo ako nema --replay" << std::endl;
+        options.recordPath.clear();
+    }
+    return options;
+}
+
+void InputRecorder::begin(unsigned newSeed, int newFishCount, double newTickRate)
+{
+    events.clear();
+    seed = newSeed;
+    fishCount = newFishCount;
+    tickRate = newTickRate;
+}
+
+void InputRecorder::record(unsigned long long tick, const AquariumInput& input)
+{
+    InputLogEvent event;
+    event.tick = tick;
+    event.input = input;
+    events.push_back(event);
+}
+
+static void writeVarint(std::vector<unsigned char>& bytes, unsigned long long value)
+{
+    //7 bita po bajtu, najvisi bit kaze da ima jos; razlike koraka su skoro uvijek jedan bajt
+    while (value >= 0x80)
+    {
+        bytes.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back((unsigned char)value);
+}
+
+static bool readVarint(const unsigned char*& data, const unsigned char* end, unsigned long long& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7)
+    {
+        unsigned char byte = *data++;
+        value |= (unsigned long long)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+static void writeBytes(std::vector<unsigned char>& bytes, const void* data, size_t size)
+{
+    const unsigned char* source = (const unsigned char*)data;
+    bytes.insert(bytes.end(), source, source + size);
+}
+
+bool InputRecorder::save(const char* filePath, unsigned long long endTick) const
+{
+    InputLogHeader header = {};
+    memcpy(header.magic, INPUT_LOG_MAGIC, sizeof(header.magic));
+    header.version = INPUT_LOG_VERSION;
+    header.seed = seed;
+    header.fishCount = fishCount;
+    header.tickRate = tickRate;
+    header.endTick = endTick;
+    header.eventCount = events.size();
+
+    std::vector<unsigned char> bytes;
+    bytes.reserve(events.size() * 10);
+    unsigned long long lastTick = 0;
+    for (const InputLogEvent& event : events)
+    {
+        writeVarint(bytes, event.tick - lastTick);
+        lastTick = event.tick;
+        bytes.push_back((unsigned char)event.input.type);
+        if (event.input.type == AquariumInput::Key)
+        {
+            short key = (short)event.input.key;
+            writeBytes(bytes, &key, sizeof(key));
+            bytes.push_back((unsigned char)event.input.action);
+        }
+        else
+        {
+            //Sirovi bitovi, da reprodukcija dobije tacno isti broj kao simulacija pri snimanju
+            writeBytes(bytes, &event.input.x, sizeof(float));
+            writeBytes(bytes, &event.input.y, sizeof(float));
+        }
+    }
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cout << "Snimak ulaza ne moze da se upise: " << filePath << std::endl;
+        return false;
+    }
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)bytes.data(), bytes.size());
+    return file.good();
+}
+
+bool InputReplay::load(const char* filePath)
+{
+    events.clear();
+    next = 0;
+    MappedFile file;
+    InputLogHeader header;
+    if (!file.open(filePath) || file.size() < sizeof(header))
+    {
+        std::cout << "Snimak ulaza ne moze da se procita: " << filePath << std::endl;
+        return false;
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, INPUT_LOG_MAGIC, sizeof(header.magic)) != 0 || header.version != INPUT_LOG_VERSION
+        || header.fishCount < 0 || !(header.tickRate > 0))
+    {
+        std::cout << "Nije snimak ulaza (ili je iz druge verzije): " << filePath << std::endl;
+        return false;
+    }
+
+    const unsigned char* data = file.data() + sizeof(header);
+    const unsigned char* end = file.data() + file.size();
+    unsigned long long tick = 0;
+    for (unsigned long long i = 0; i < header.eventCount; i++)
+    {
+        InputLogEvent event;
+        unsigned long long delta;
+        if (!readVarint(data, end, delta) || data >= end) break;
+        tick += delta;
+        event.tick = tick;
+        unsigned char type = *data++;
+        if (type == AquariumInput::Key && end - data >= 3)
+        {
+            short key;
+            memcpy(&key, data, sizeof(key));
+            event.input.type = AquariumInput::Key;
+            event.input.key = key;
+            event.input.action = data[2];
+            data += 3;
+        }
+        else if ((type == AquariumInput::Feed || type == AquariumInput::Cursor) && end - data >= 8)
+        {
+            event.input.type = (AquariumInput::Type)type;
+            memcpy(&event.input.x, data, sizeof(float));
+            memcpy(&event.input.y, data + 4, sizeof(float));
+            data += 8;
+        }
+        else break;
+        events.push_back(event);
+    }
+    if (events.size() != header.eventCount)
+    {
+        std::cout << "Snimak ulaza je ostecen: " << filePath << " (" << events.size() << " od " << header.eventCount
+            << " dogadjaja)" << std::endl;
+        return false;
+    }
+
+    seed = header.seed;
+    fishCount = header.fishCount;
+    tickRate = header.tickRate;
+    endTick = header.endTick;
+    return true;
+}
+
+void InputReplay::applyDue(Aquarium& aquarium)
+{
+    while (next < events.size() && events[next].tick <= aquarium.getTick()) aquarium.apply(events[next++].input);
+}
+
+unsigned long long aquariumChecksum(const Aquarium& aquarium)
+{
+    const std::vector<FishState>& fish = aquarium.getFish();
+    return hashBytes(fish.data(), fish.size() * sizeof(FishState), aquarium.getTick());
+}
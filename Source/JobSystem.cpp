@@ -0,0 +1,379 @@
+#include "../Header/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "../Header/BlockCompression.h"
+
+// Opis: radne niti sa Chase-Lev redovima (kradja posla), brojaci zavisnosti i paralelna petlja
+
+struct JobCounter::Job {
+    std::function<void()> work;
+    JobCounter* counter;
+};
+
+// Chase-Lev red fiksne velicine (Le, Pop, Cohen, Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak
+// Memory Models"). push i pop zove samo vlasnik, steal bilo koja nit.
+class JobSystem::WorkQueue {
+public:
+    static const long long CAPACITY = 4096;
+
+    bool push(Job* job)
+    {
+        long long b = bottom.load(std::memory_order_relaxed);
+        long long t = top.load(std::memory_order_acquire);
+        if (b - t >= CAPACITY) return false;
+        items[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release); //Kradljivac koji vidi novi bottom vidi i posao
+        return true;
+    }
+
+    Job* pop()
+    {
+        long long b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = top.load(std::memory_order_relaxed);
+        if (t > b)
+        {
+            bottom.store(b + 1, std::memory_order_relaxed); //Red je bio prazan
+            return nullptr;
+        }
+        Job* job = items[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            //Poslednji posao: trka sa kradljivcem, pobjedjuje ko prvi pomjeri top
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) job = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* steal()
+    {
+        long long t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Job* job = items[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+        return job;
+    }
+
+private:
+    alignas(64) std::atomic<long long> top{ 0 };
+    alignas(64) std::atomic<long long> bottom{ 0 };
+    std::atomic<Job*> items[CAPACITY];
+};
+
+//Kojoj radnoj niti kog sistema pripada tekuca nit
+static thread_local const JobSystem* threadSystem = nullptr;
+static thread_local int threadIndex = -1;
+
+JobSystem::JobSystem(unsigned threadCount)
+{
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    ownerThread = std::this_thread::get_id();
+    for (unsigned i = 0; i < threadCount; i++) queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    for (unsigned i = 1; i < threadCount; i++) workers.emplace_back(&JobSystem::workerLoop, this, (int)i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wakeup.notify_all();
+    for (std::thread& worker : workers) worker.join();
+
+    //Poslovi koje niko nije stigao da uzme se ne izvrsavaju (sistem se gasi), samo brisu; posle join redovi su samo nasi
+    for (std::unique_ptr<WorkQueue>& queue : queues)
+    {
+        while (Job* job = queue->steal()) delete job;
+    }
+    for (Job* job : injected) delete job;
+    injected.clear();
+}
+
+int JobSystem::currentIndex() const
+{
+    if (threadSystem == this) return threadIndex;
+    if (std::this_thread::get_id() == ownerThread) return 0;
+    return -1;
+}
+
+void JobSystem::run(std::function<void()> work, JobCounter* counter)
+{
+    if (counter != nullptr) counter->pending.fetch_add(1, std::memory_order_relaxed);
+    push(new Job{ std::move(work), counter });
+    wakeWorkers(false);
+}
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void()> work, JobCounter* counter)
+{
+    if (counter != nullptr) counter->pending.fetch_add(1, std::memory_order_relaxed);
+    Job* job = new Job{ std::move(work), counter };
+    {
+        //Isti mutex drzi i finish kad brojac padne na nulu, pa se nastavak ne moze izgubiti
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if (dependency.pending.load(std::memory_order_acquire) > 0)
+        {
+            dependency.continuations.push_back(job);
+            return;
+        }
+    }
+    push(job);
+    wakeWorkers(false);
+}
+
+void JobSystem::push(Job* job)
+{
+    int index = currentIndex();
+    if (index < 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(injectMutex);
+            injected.push_back(job);
+            injectedCount.fetch_add(1);
+        }
+        queued.fetch_add(1);
+        return;
+    }
+    if (!queues[index]->push(job))
+    {
+        //Red je pun: posao se izvrsava odmah umjesto da se ceka mjesto
+        inlined.fetch_add(1, std::memory_order_relaxed);
+        execute(job);
+        return;
+    }
+    queued.fetch_add(1);
+}
+
+JobSystem::Job* JobSystem::findJob(int index)
+{
+    if (index >= 0)
+    {
+        Job* job = queues[index]->pop();
+        if (job != nullptr)
+        {
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+    if (injectedCount.load(std::memory_order_acquire) > 0)
+    {
+        std::lock_guard<std::mutex> lock(injectMutex);
+        if (!injected.empty())
+        {
+            Job* job = injected.front();
+            injected.pop_front();
+            injectedCount.fetch_sub(1);
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+    //Kradja: pocinje od susjeda, da sve niti ne napadaju isti red
+    int count = (int)queues.size();
+    for (int i = 1; i <= count; i++)
+    {
+        int victim = (index + i + count) % count;
+        if (victim == index) continue;
+        Job* job = queues[victim]->steal();
+        if (job != nullptr)
+        {
+            stolen.fetch_add(1, std::memory_order_relaxed);
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(Job* job)
+{
+    job->work();
+    JobCounter* counter = job->counter;
+    delete job;
+    executed.fetch_add(1, std::memory_order_relaxed);
+    if (counter != nullptr) finish(counter);
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        ready.swap(counter->continuations);
+    }
+    for (Job* job : ready) push(job);
+    if (!ready.empty()) wakeWorkers(ready.size() > 1);
+}
+
+void JobSystem::wakeWorkers(bool all)
+{
+    if (sleeping.load() == 0) return;
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    if (all) wakeup.notify_all();
+    else wakeup.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    int index = currentIndex();
+    while (!counter.isDone())
+    {
+        Job* job = findJob(index);
+        if (job != nullptr) execute(job);
+        else std::this_thread::yield();
+    }
+    //finish smanjuje brojac pod mutexom; brojac se smije unistiti tek kad ga finish pusti
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+void JobSystem::workerLoop(int index)
+{
+    threadSystem = this;
+    threadIndex = index;
+    int idleSpins = 0;
+    while (!stopping.load(std::memory_order_acquire))
+    {
+        Job* job = findJob(index);
+        if (job != nullptr)
+        {
+            execute(job);
+            idleSpins = 0;
+            continue;
+        }
+        if (++idleSpins < 64)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        //Nema posla: nit spava dok ne bude poslova u redovima, bez budjenja na timeout. Posao dodat izmedju posljednje
+        //provjere i uspavljivanja se ne gubi: push povecava queued pa cita sleeping, a nit povecava sleeping pa cita
+        //queued (sve seq_cst), pa bar jedna strana vidi drugu - ili nit ne zaspi, ili wakeWorkers zove notify.
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleeping.fetch_add(1);
+        wakeup.wait(lock, [this]() { return stopping.load() || queued.load() > 0; });
+        sleeping.fetch_sub(1);
+        idleSpins = 0;
+    }
+}
+
+void JobSystem::parallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body)
+{
+    if (end <= begin) return;
+    int range = end - begin;
+    if (grain < 1) grain = 1;
+    //Nekoliko dijelova po niti, da kradja posla moze da izravna dijelove razlicite tezine
+    int chunks = std::min((range + grain - 1) / grain, (int)getThreadCount() * 4);
+    if (chunks <= 1 || getThreadCount() == 1)
+    {
+        body(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+    int chunkSize = (range + chunks - 1) / chunks;
+    for (int start = begin + chunkSize; start < end; start += chunkSize)
+    {
+        int stop = std::min(start + chunkSize, end);
+        run([&body, start, stop]() { body(start, stop); }, &counter);
+    }
+    body(begin, std::min(begin + chunkSize, end)); //Prvi dio radi nit koja ceka
+    wait(counter);
+}
+
+JobSystemStats JobSystem::getStats() const
+{
+    JobSystemStats stats;
+    stats.executed = executed.load();
+    stats.stolen = stolen.load();
+    stats.inlined = inlined.load();
+    return stats;
+}
+
+JobSystem& jobSystem()
+{
+    static JobSystem system;
+    return system;
+}
+
+struct BenchParticle {
+    float x, y, vx, vy;
+};
+
+static void updateParticles(BenchParticle* particles, int begin, int end, float dt)
+{
+    for (int i = begin; i < end; i++)
+    {
+        BenchParticle& p = particles[i];
+        //Malo racunanja po cestici, da posao ne bude ogranicen samo propusnoscu memorije
+        float angle = std::atan2(p.vy, p.vx) + 0.3f * dt;
+        float speed = std::sqrt(p.vx * p.vx + p.vy * p.vy);
+        p.vx = std::cos(angle) * speed;
+        p.vy = std::sin(angle) * speed - 0.1f * dt;
+        p.x += p.vx * dt;
+        p.y += p.vy * dt;
+    }
+}
+
+void printJobSystemBenchmark()
+{
+    const int imageSize = 1024;
+    const int particleCount = 1 << 20;
+    const int repeats = 3;
+
+    std::vector<unsigned char> image((size_t)imageSize * imageSize * 4);
+    for (int y = 0; y < imageSize; y++)
+        for (int x = 0; x < imageSize; x++)
+        {
+            unsigned char* pixel = &image[((size_t)y * imageSize + x) * 4];
+            pixel[0] = (unsigned char)(x ^ y);
+            pixel[1] = (unsigned char)(x * 3 + y);
+            pixel[2] = (unsigned char)((x * y) >> 4);
+            pixel[3] = 255;
+        }
+    std::vector<unsigned char> blocks(blockCompressedSize(TextureCompression::BC1, imageSize, imageSize));
+    std::vector<BenchParticle> particles(particleCount);
+    for (int i = 0; i < particleCount; i++) particles[i] = { 0.0f, 0.0f, std::cos((float)i), std::sin((float)i) };
+
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Sistem poslova: " << hardwareThreads << " jezgara, najbolje od " << repeats << " ponavljanja" << std::endl;
+    std::cout << std::left << std::setw(8) << "niti" << std::setw(14) << "BC1 ms" << std::setw(12) << "ubrzanje"
+        << std::setw(14) << "cestice ms" << std::setw(12) << "ubrzanje" << "ukradeno" << std::endl;
+
+    double baseBlocks = 0, baseParticles = 0;
+    for (unsigned threads = 1; threads <= hardwareThreads; threads++)
+    {
+        JobSystem jobs(threads);
+        double bestBlocks = 1e30, bestParticles = 1e30;
+        for (int r = 0; r < repeats; r++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            compressImageBlocks(TextureCompression::BC1, image.data(), imageSize, imageSize, blocks.data(), &jobs);
+            auto middle = std::chrono::steady_clock::now();
+            jobs.parallelFor(0, particleCount, 4096, [&](int begin, int end) {
+                updateParticles(particles.data(), begin, end, 1.0f / 60.0f);
+            });
+            auto stop = std::chrono::steady_clock::now();
+            bestBlocks = std::min(bestBlocks, std::chrono::duration<double, std::milli>(middle - start).count());
+            bestParticles = std::min(bestParticles, std::chrono::duration<double, std::milli>(stop - middle).count());
+        }
+        if (threads == 1)
+        {
+            baseBlocks = bestBlocks;
+            baseParticles = bestParticles;
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(8) << threads
+            << std::setw(14) << bestBlocks << std::setw(12) << baseBlocks / bestBlocks
+            << std::setw(14) << bestParticles << std::setw(12) << baseParticles / bestParticles
+            << jobs.getStats().stolen << std::endl;
+    }
+}
@@ -0,0 +1,355 @@
+#include "../Header/Ktx2.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "../Header/BlockCompression.h"
+#include "../Header/MappedFile.h"
+
+// Opis: citanje i pisanje KTX2 fajlova (bez superkompresije, jedna 2D slika sa mip nivoima)
+
+static const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+// Vulkan formati koje koristimo (KTX2 opisuje format preko VkFormat vrijednosti)
+enum Ktx2VkFormat : unsigned {
+    VK_FORMAT_R8_UNORM = 9,
+    VK_FORMAT_R8G8_UNORM = 16,
+    VK_FORMAT_R8G8B8_UNORM = 23,
+    VK_FORMAT_R8G8B8A8_UNORM = 37,
+    VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131,
+    VK_FORMAT_BC3_UNORM_BLOCK = 137,
+    VK_FORMAT_BC7_UNORM_BLOCK = 145,
+};
+
+struct Ktx2Header {
+    unsigned char identifier[12];
+    unsigned vkFormat;
+    unsigned typeSize;
+    unsigned pixelWidth;
+    unsigned pixelHeight;
+    unsigned pixelDepth;
+    unsigned layerCount;
+    unsigned faceCount;
+    unsigned levelCount;
+    unsigned supercompressionScheme;
+    unsigned dfdByteOffset;
+    unsigned dfdByteLength;
+    unsigned kvdByteOffset;
+    unsigned kvdByteLength;
+    unsigned long long sgdByteOffset;
+    unsigned long long sgdByteLength;
+};
+
+struct Ktx2LevelIndex {
+    unsigned long long byteOffset;
+    unsigned long long byteLength;
+    unsigned long long uncompressedByteLength;
+};
+
+static_assert(sizeof(Ktx2Header) == 80, "KTX2 zaglavlje mora imati 80 bajtova");
+static_assert(sizeof(Ktx2LevelIndex) == 24, "KTX2 indeks nivoa mora imati 24 bajta");
+
+static bool vkFormatToGL(unsigned vkFormat, GLenum& format, TextureCompression& compression)
+{
+    compression = TextureCompression::None;
+    switch (vkFormat) {
+    case VK_FORMAT_R8_UNORM: format = GL_RED; return true;
+    case VK_FORMAT_R8G8_UNORM: format = GL_RG; return true;
+    case VK_FORMAT_R8G8B8_UNORM: format = GL_RGB; return true;
+    case VK_FORMAT_R8G8B8A8_UNORM: format = GL_RGBA; return true;
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK: compression = TextureCompression::BC1; break;
+    case VK_FORMAT_BC3_UNORM_BLOCK: compression = TextureCompression::BC3; break;
+    case VK_FORMAT_BC7_UNORM_BLOCK: compression = TextureCompression::BC7; break;
+    default: return false;
+    }
+    format = textureCompressionFormat(compression);
+    return true;
+}
+
+// Model boja u DFD-u koji odgovara formatu (Khronos Data Format, khr_df.h)
+static unsigned vkFormatColorModel(unsigned vkFormat)
+{
+    switch (vkFormat) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK: return 128; // KHR_DF_MODEL_BC1A
+    case VK_FORMAT_BC3_UNORM_BLOCK: return 130; // KHR_DF_MODEL_BC3
+    case VK_FORMAT_BC7_UNORM_BLOCK: return 134; // KHR_DF_MODEL_BC7 (BPTC)
+    default: return 1; // KHR_DF_MODEL_RGBSDA
+    }
+}
+
+static unsigned glFormatToVk(GLenum format)
+{
+    switch (format) {
+    case GL_RED: return VK_FORMAT_R8_UNORM;
+    case GL_RG: return VK_FORMAT_R8G8_UNORM;
+    case GL_RGB: return VK_FORMAT_R8G8B8_UNORM;
+    case GL_RGBA: return VK_FORMAT_R8G8B8A8_UNORM;
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: return VK_FORMAT_BC3_UNORM_BLOCK;
+    case GL_COMPRESSED_RGBA_BPTC_UNORM: return VK_FORMAT_BC7_UNORM_BLOCK;
+    default: return 0;
+    }
+}
+
+unsigned loadKtx2Texture(const char* filePath, Ktx2Info* info)
+{
+    MappedFile file;
+    if (!file.open(filePath) || file.size() < sizeof(Ktx2Header))
+    {
+        std::cout << "KTX2 fajl nije ucitan! Putanja: " << filePath << std::endl;
+        return 0;
+    }
+
+    Ktx2Header header;
+    memcpy(&header, file.data(), sizeof(header));
+    GLenum format;
+    TextureCompression compression;
+    if (memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0
+        || header.supercompressionScheme != 0 || header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1
+        || header.pixelWidth == 0 || header.pixelHeight == 0 || !vkFormatToGL(header.vkFormat, format, compression))
+    {
+        std::cout << "KTX2 fajl nije podrzan (dozvoljena je samo obicna 2D slika bez superkompresije): " << filePath << std::endl;
+        return 0;
+    }
+
+    unsigned levelCount = header.levelCount > 0 ? header.levelCount : 1;
+    unsigned maxLevels = 1;
+    while ((std::max(header.pixelWidth, header.pixelHeight) >> maxLevels) > 0) maxLevels++;
+    if (levelCount > maxLevels || file.size() < sizeof(header) + levelCount * sizeof(Ktx2LevelIndex))
+    {
+        std::cout << "KTX2 fajl ima neispravnu tabelu nivoa: " << filePath << std::endl;
+        return 0;
+    }
+
+    std::vector<TextureLevel> levels(levelCount);
+    for (unsigned i = 0; i < levelCount; i++)
+    {
+        Ktx2LevelIndex index;
+        memcpy(&index, file.data() + sizeof(header) + i * sizeof(index), sizeof(index));
+        if (index.byteOffset + index.byteLength > file.size())
+        {
+            std::cout << "KTX2 fajl je odsjecen: " << filePath << std::endl;
+            return 0;
+        }
+        levels[i].width = (int)(header.pixelWidth >> i) > 0 ? (int)(header.pixelWidth >> i) : 1;
+        levels[i].height = (int)(header.pixelHeight >> i) > 0 ? (int)(header.pixelHeight >> i) : 1;
+        levels[i].offset = (size_t)index.byteOffset;
+        levels[i].size = (size_t)index.byteLength;
+
+        size_t expected = compression != TextureCompression::None ? blockCompressedSize(compression, levels[i].width, levels[i].height)
+            : (size_t)levels[i].width * levels[i].height * textureChannelsForFormat(format);
+        if (levels[i].size < expected)
+        {
+            std::cout << "KTX2 nivo " << i << " je manji nego sto format zahtijeva: " << filePath << std::endl;
+            return 0;
+        }
+    }
+
+    bool premultiplied = false;
+    if (header.dfdByteLength >= 16 && header.dfdByteOffset + header.dfdByteLength <= file.size())
+    {
+        //Ukupna velicina DFD-a, pa osnovni blok; u trecem 32-bitnom polju bloka model boja je najnizi, a flags najvisi bajt
+        unsigned word;
+        memcpy(&word, file.data() + header.dfdByteOffset + 12, 4);
+        if ((word & 0xFF) != vkFormatColorModel(header.vkFormat))
+        {
+            std::cout << "KTX2 DFD opisuje model boja " << (word & 0xFF) << ", a vkFormat " << header.vkFormat
+                << " zahtijeva " << vkFormatColorModel(header.vkFormat) << ": " << filePath << std::endl;
+            return 0;
+        }
+        premultiplied = ((word >> 24) & 1) != 0;
+    }
+
+    if (info != nullptr)
+    {
+        info->width = (int)header.pixelWidth;
+        info->height = (int)header.pixelHeight;
+        info->levelCount = (int)levelCount;
+        info->format = format;
+        info->compressed = compression != TextureCompression::None;
+        info->premultipliedAlpha = premultiplied;
+    }
+
+    if (compression == TextureCompression::None || isTextureCompressionSupported(compression))
+        return uploadTexture(format, compression != TextureCompression::None, levels.data(), levels.size(), file.data());
+
+    //Drajver ne zna da cita ovaj blok format, pa ga (samo u tom slucaju) dekodujemo na procesoru
+    TextureImage image;
+    image.format = GL_RGBA;
+    layoutTextureLevels(levels[0].width, levels[0].height, 4, levelCount > 1, image.levels);
+    image.levels.resize(levelCount);
+    const TextureLevel& last = image.levels.back();
+    image.pixels.resize(last.offset + last.size);
+    for (unsigned i = 0; i < levelCount; i++)
+        decompressImageBlocks(compression, file.data() + levels[i].offset, levels[i].width, levels[i].height, &image.pixels[image.levels[i].offset]);
+    if (info != nullptr)
+    {
+        info->format = GL_RGBA;
+        info->compressed = false;
+    }
+    return uploadTexture(image);
+}
+
+bool readKtx2KeyValue(const char* filePath, const char* key, std::string& value)
+{
+    MappedFile file;
+    if (!file.open(filePath) || file.size() < sizeof(Ktx2Header)) return false;
+    Ktx2Header header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0
+        || (size_t)header.kvdByteOffset + header.kvdByteLength > file.size()) return false;
+
+    //Svaki par: duzina (4 bajta), kljuc\0 vrijednost\0, dopuna do 4 bajta
+    const unsigned char* data = file.data() + header.kvdByteOffset;
+    size_t position = 0;
+    size_t keyLength = strlen(key);
+    while (position + 4 <= header.kvdByteLength)
+    {
+        unsigned length;
+        memcpy(&length, data + position, 4);
+        position += 4;
+        if (length > header.kvdByteLength - position) return false;
+        const char* pair = (const char*)data + position;
+        if (length > keyLength && memcmp(pair, key, keyLength) == 0 && pair[keyLength] == 0)
+        {
+            //Vrijednost je obicno zavrsena nulom, ali standard to ne zahtijeva
+            size_t valueLength = length - keyLength - 1;
+            if (valueLength > 0 && pair[keyLength + valueLength] == 0) valueLength--;
+            value.assign(pair + keyLength + 1, valueLength);
+            return true;
+        }
+        position += (length + 3) / 4 * 4;
+    }
+    return false;
+}
+
+static void writeU32(std::vector<unsigned char>& out, unsigned value)
+{
+    for (int i = 0; i < 4; i++) out.push_back((unsigned char)(value >> (i * 8)));
+}
+
+static void writeKeyValue(std::vector<unsigned char>& out, const std::string& key, const std::string& value)
+{
+    writeU32(out, (unsigned)(key.size() + 1 + value.size() + 1));
+    out.insert(out.end(), key.begin(), key.end());
+    out.push_back(0);
+    out.insert(out.end(), value.begin(), value.end());
+    out.push_back(0);
+    while (out.size() % 4 != 0) out.push_back(0);
+}
+
+// Osnovni Khronos Data Format deskriptor (KDF) za formate koje pisemo
+static std::vector<unsigned char> buildDataFormatDescriptor(unsigned vkFormat, bool premultipliedAlpha)
+{
+    struct Sample { unsigned bitOffset, bitLength, channel, upper; };
+    std::vector<Sample> samples;
+    unsigned colorModel = vkFormatColorModel(vkFormat);
+    unsigned blockDimension = 0; // Dimenzije bloka minus 1 (po bajt za x, y, z, t)
+    unsigned bytesPlane0 = 0;
+
+    switch (vkFormat) {
+    case VK_FORMAT_R8_UNORM:
+    case VK_FORMAT_R8G8_UNORM:
+    case VK_FORMAT_R8G8B8_UNORM:
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    {
+        unsigned channels = vkFormat == VK_FORMAT_R8_UNORM ? 1 : vkFormat == VK_FORMAT_R8G8_UNORM ? 2 : vkFormat == VK_FORMAT_R8G8B8_UNORM ? 3 : 4;
+        const unsigned channelIds[4] = { 0, 1, 2, 15 }; // R, G, B, A
+        for (unsigned c = 0; c < channels; c++) samples.push_back({ c * 8, 8, channelIds[c], 255 });
+        bytesPlane0 = channels;
+        break;
+    }
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        blockDimension = 3 | (3 << 8);
+        bytesPlane0 = 8;
+        samples.push_back({ 0, 64, 0, 0xFFFFFFFFu });
+        break;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+        blockDimension = 3 | (3 << 8);
+        bytesPlane0 = 16;
+        samples.push_back({ 0, 64, 15, 0xFFFFFFFFu });
+        samples.push_back({ 64, 64, 0, 0xFFFFFFFFu });
+        break;
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+        blockDimension = 3 | (3 << 8);
+        bytesPlane0 = 16;
+        samples.push_back({ 0, 128, 0, 0xFFFFFFFFu });
+        break;
+    }
+
+    unsigned blockSize = 24 + 16 * (unsigned)samples.size();
+    std::vector<unsigned char> dfd;
+    writeU32(dfd, 4 + blockSize); // Ukupna velicina
+    writeU32(dfd, 0); // vendorId = Khronos, descriptorType = basic
+    writeU32(dfd, 2 | (blockSize << 16)); // Verzija 1.3
+    writeU32(dfd, colorModel | (1 << 8) | (1 << 16) | ((premultipliedAlpha ? 1u : 0u) << 24)); // BT709, linearno
+    writeU32(dfd, blockDimension);
+    writeU32(dfd, bytesPlane0);
+    writeU32(dfd, 0);
+    for (const Sample& sample : samples)
+    {
+        writeU32(dfd, sample.bitOffset | ((sample.bitLength - 1) << 16) | (sample.channel << 24));
+        writeU32(dfd, 0);
+        writeU32(dfd, 0);
+        writeU32(dfd, sample.upper);
+    }
+    return dfd;
+}
+
+bool writeKtx2(const char* filePath, const TextureImage& image, bool premultipliedAlpha, const std::string& bakeOptions)
+{
+    unsigned vkFormat = glFormatToVk(image.format);
+    if (vkFormat == 0 || image.levels.empty()) return false;
+
+    std::vector<unsigned char> dfd = buildDataFormatDescriptor(vkFormat, premultipliedAlpha);
+    std::vector<unsigned char> kvd;
+    writeKeyValue(kvd, "KTXorientation", "ru"); //Prvi red je dole, kao sto OpenGL ocekuje
+    writeKeyValue(kvd, "KTXwriter", "Kostur --bake-ktx2");
+    //Kljucevi idu poredani po bajtovima, pa nasi (bez prefiksa KTX) dolaze posle standardnih
+    if (!bakeOptions.empty()) writeKeyValue(kvd, KTX2_BAKE_OPTIONS_KEY, bakeOptions);
+
+    Ktx2Header header = {};
+    memcpy(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+    header.vkFormat = vkFormat;
+    header.typeSize = 1;
+    header.pixelWidth = (unsigned)image.levels[0].width;
+    header.pixelHeight = (unsigned)image.levels[0].height;
+    header.faceCount = 1;
+    header.levelCount = (unsigned)image.levels.size();
+    header.dfdByteOffset = (unsigned)(sizeof(Ktx2Header) + image.levels.size() * sizeof(Ktx2LevelIndex));
+    header.dfdByteLength = (unsigned)dfd.size();
+    header.kvdByteOffset = header.dfdByteOffset + header.dfdByteLength;
+    header.kvdByteLength = (unsigned)kvd.size();
+
+    //Nivoi idu od najmanjeg ka najvecem, svaki poravnat na velicinu teksela/bloka (i na 4 bajta)
+    size_t alignment = image.compressed ? (vkFormat == VK_FORMAT_BC1_RGB_UNORM_BLOCK ? 8 : 16)
+        : (vkFormat == VK_FORMAT_R8G8B8_UNORM ? 12 : 4);
+    size_t offset = header.kvdByteOffset + header.kvdByteLength;
+    std::vector<Ktx2LevelIndex> index(image.levels.size());
+    for (size_t i = image.levels.size(); i-- > 0;)
+    {
+        offset = (offset + alignment - 1) / alignment * alignment;
+        index[i].byteOffset = offset;
+        index[i].byteLength = image.levels[i].size;
+        index[i].uncompressedByteLength = image.levels[i].size;
+        offset += image.levels[i].size;
+    }
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)index.data(), index.size() * sizeof(Ktx2LevelIndex));
+    file.write((const char*)dfd.data(), dfd.size());
+    file.write((const char*)kvd.data(), kvd.size());
+    size_t written = header.kvdByteOffset + header.kvdByteLength;
+    for (size_t i = image.levels.size(); i-- > 0;)
+    {
+        const char padding[16] = {};
+        file.write(padding, index[i].byteOffset - written);
+        file.write((const char*)&image.pixels[image.levels[i].offset], image.levels[i].size);
+        written = index[i].byteOffset + index[i].byteLength;
+    }
+    return file.good();
+}
@@ -0,0 +1,163 @@
+#include "../Header/Ktx2.h"
+
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "../Header/BlockCompression.h"
+#include "../Header/JobSystem.h"
+
+// Opis: priprema tekstura unaprijed - PNG/JPEG slike iz foldera se dekoduju postojecim stb dekoderima,
+// po potrebi premnoze alfom, dobiju mip nivoe i blok kompresiju, i upisu kao .ktx2
+
+namespace fs = std::filesystem;
+
+static bool isSourceImage(const fs::path& path)
+{
+    std::string extension = path.extension().string();
+    for (char& c : extension) c = (char)tolower((unsigned char)c);
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".tga";
+}
+
+static bool parseCompression(const std::string& name, TextureCompression& compression)
+{
+    if (name == "none") compression = TextureCompression::None;
+    else if (name == "auto") compression = TextureCompression::Auto;
+    else if (name == "bc1") compression = TextureCompression::BC1;
+    else if (name == "bc3") compression = TextureCompression::BC3;
+    else if (name == "bc7") compression = TextureCompression::BC7;
+    else return false;
+    return true;
+}
+
+// Opisuje opcije koje mijenjaju sadrzaj .ktx2 fajla; upisuje se u fajl i poredi pri sledecem pecenju
+static std::string describeBakeOptions(const std::string& formatName, bool premultiply, bool mipmaps)
+{
+    return "format=" + formatName + " premultiply=" + (premultiply ? "1" : "0") + " mips=" + (mipmaps ? "1" : "0");
+}
+
+static void premultiplyAlpha(TextureImage& image)
+{
+    const TextureLevel& level = image.levels[0];
+    unsigned char* pixels = &image.pixels[level.offset];
+    for (size_t i = 0; i < level.size; i += 4)
+    {
+        for (int c = 0; c < 3; c++)
+            pixels[i + c] = (unsigned char)((pixels[i + c] * pixels[i + 3] + 127) / 255);
+    }
+}
+
+static bool bakeImage(const fs::path& inputPath, const fs::path& outputPath, TextureCompression compression, bool premultiply, bool mipmaps,
+    const std::string& options, std::string& report)
+{
+    auto start = std::chrono::steady_clock::now();
+    TextureImage image;
+    if (!decodeImageFile(inputPath.string().c_str(), TextureLoadOptions(), image))
+    {
+        report = "  " + inputPath.filename().string() + ": slika nije ucitana";
+        return false;
+    }
+
+    bool hasAlpha = textureImageHasAlpha(image);
+    //Premnozavamo prije pravljenja mip nivoa, da se boje providnih piksela ne bi razlivale po ivicama
+    bool premultiplied = premultiply && hasAlpha;
+    if (premultiplied) premultiplyAlpha(image);
+    if (mipmaps) generateTextureMipmaps(image);
+
+    TextureCompression format = compression;
+    if (format == TextureCompression::Auto) format = hasAlpha ? TextureCompression::BC7 : TextureCompression::BC1;
+    if (format != TextureCompression::None) encodeTextureImage(image, format);
+
+    if (!writeKtx2(outputPath.string().c_str(), image, premultiplied, options))
+    {
+        report = "  " + outputPath.string() + ": upis nije uspio";
+        return false;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::error_code error;
+    std::ostringstream text;
+    text << "  " << inputPath.filename().string() << " -> " << outputPath.filename().string()
+        << " (" << image.levels[0].width << "x" << image.levels[0].height << ", " << image.levels.size() << " nivoa, "
+        << fs::file_size(inputPath, error) / 1024 << " KB -> " << fs::file_size(outputPath, error) / 1024 << " KB, "
+        << seconds * 1000.0 << " ms)";
+    report = text.str();
+    return true;
+}
+
+int runKtx2Baker(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        std::cout << "Upotreba: " << argv[0] << " --bake-ktx2 <ulazni folder> <izlazni folder> [--format none|auto|bc1|bc3|bc7] [--premultiply] [--no-mips]" << std::endl;
+        return 1;
+    }
+    fs::path inputDirectory = argv[2];
+    fs::path outputDirectory = argv[3];
+    TextureCompression compression = TextureCompression::Auto;
+    std::string formatName = "auto";
+    bool premultiply = false;
+    bool mipmaps = true;
+    for (int i = 4; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--format" && i + 1 < argc && parseCompression(argv[i + 1], compression)) formatName = argv[++i];
+        else if (argument == "--premultiply") premultiply = true;
+        else if (argument == "--no-mips") mipmaps = false;
+        else
+        {
+            std::cout << "Nepoznat argument: " << argument << std::endl;
+            return 1;
+        }
+    }
+
+    std::error_code error;
+    fs::create_directories(outputDirectory, error);
+    if (error || !fs::is_directory(inputDirectory))
+    {
+        std::cout << "Folderi \"" << inputDirectory.string() << "\" ili \"" << outputDirectory.string() << "\" nisu dostupni." << std::endl;
+        return 1;
+    }
+
+    std::string options = describeBakeOptions(formatName, premultiply, mipmaps);
+    int baked = 0, skipped = 0, failed = 0;
+    std::vector<fs::path> inputs;
+    for (const fs::directory_entry& entry : fs::directory_iterator(inputDirectory, error))
+    {
+        if (!entry.is_regular_file() || !isSourceImage(entry.path())) continue;
+        fs::path outputPath = outputDirectory / entry.path().filename().replace_extension(".ktx2");
+
+        //Preskacemo slike koje se nisu mijenjale od poslednjeg pecenja, ako je i tada peceno istim opcijama
+        std::error_code timeError;
+        std::string previousOptions;
+        if (fs::exists(outputPath) && fs::last_write_time(outputPath, timeError) >= fs::last_write_time(entry.path(), timeError) && !timeError
+            && readKtx2KeyValue(outputPath.string().c_str(), KTX2_BAKE_OPTIONS_KEY, previousOptions) && previousOptions == options)
+        {
+            skipped++;
+            continue;
+        }
+        inputs.push_back(entry.path());
+    }
+
+    //Slike se peku paralelno (po jedna na posao), a izvjestaji se ispisuju redom kad sve budu gotove
+    std::vector<std::string> reports(inputs.size());
+    std::vector<char> succeeded(inputs.size());
+    jobSystem().parallelFor(0, (int)inputs.size(), 1, [&](int first, int last) {
+        for (int i = first; i < last; i++)
+        {
+            fs::path outputPath = outputDirectory / inputs[i].filename().replace_extension(".ktx2");
+            succeeded[i] = bakeImage(inputs[i], outputPath, compression, premultiply, mipmaps, options, reports[i]);
+        }
+    });
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        std::cout << reports[i] << std::endl;
+        if (succeeded[i]) baked++;
+        else failed++;
+    }
+
+    std::cout << "KTX2: " << baked << " upisano, " << skipped << " neizmijenjeno, " << failed << " gresaka" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -1,37 +1,507 @@
 ﻿#include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <iostream>
+#include <memory>
 
 #include "../Header/Util.h"
+#include "../Header/Aquarium.h"
+#include "../Header/AquariumWindow.h"
+#include "../Header/BlockCompression.h"
+#include "../Header/Boids.h"
+#include "../Header/DynamicResolution.h"
+#include "../Header/EntityStore.h"
+#include "../Header/FishRenderer.h"
+#include "../Header/FramePacer.h"
+#include "../Header/FrameScheduler.h"
+#include "../Header/FrameUniforms.h"
+#include "../Header/GLStateCache.h"
+#include "../Header/GpuProfiler.h"
+#include "../Header/Headless.h"
+#include "../Header/InputLog.h"
+#include "../Header/JobSystem.h"
+#include "../Header/Ktx2.h"
+#include "../Header/ProgramCache.h"
+#include "../Header/RedrawScheduler.h"
+#include "../Header/RenderTarget.h"
+#include "../Header/ShaderRegistry.h"
+#include "../Header/SimulationThread.h"
+#include "../Header/TextureCache.h"
+#include "../Header/TextureResidency.h"
 
 // Main fajl funkcija sa osnovnim komponentama OpenGL programa
 
 // Projekat je dozvoljeno pisati počevši od ovog kostura
 // Toplo se preporučuje razdvajanje koda po fajlovima (i eventualno potfolderima) !!!
 // Srećan rad!
-int main()
+
+static const int AQUARIUM_FISH = 200;
+static const unsigned AQUARIUM_SEED = 1234;
+
+// Dogadjaji sa ulaza skupljeni u glfwPollEvents, predaju se simulaciji jednom po frejmu
+static std::vector<AquariumInput> pendingInput;
+
+static void submitInput(GLFWwindow* window, const AquariumInput& input)
+{
+    //Dodatni prozori imaju svoju simulaciju, kojoj dogadjaj ide odmah
+    AquariumWindow* extra = (AquariumWindow*)glfwGetWindowUserPointer(window);
+    if (extra != nullptr) extra->submitInput(input);
+    else pendingInput.push_back(input);
+}
+
+static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    if (button != GLFW_MOUSE_BUTTON_LEFT || action != GLFW_PRESS) return;
+    //Klik hrani ribe: pozicija kursora u NDC koordinate akvarijuma
+    double x, y;
+    int width, height;
+    glfwGetCursorPos(window, &x, &y);
+    glfwGetWindowSize(window, &width, &height);
+    if (width <= 0 || height <= 0) return;
+    AquariumInput input;
+    input.type = AquariumInput::Feed;
+    input.x = (float)(x / width * 2.0 - 1.0);
+    input.y = (float)(1.0 - y / height * 2.0);
+    submitInput(window, input);
+}
+
+static void cursorPosCallback(GLFWwindow* window, double x, double y)
 {
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    int width, height;
+    glfwGetWindowSize(window, &width, &height);
+    if (width <= 0 || height <= 0) return;
+    AquariumInput input;
+    input.type = AquariumInput::Cursor;
+    input.x = (float)(x / width * 2.0 - 1.0);
+    input.y = (float)(1.0 - y / height * 2.0);
+    //Uzastopna pomeranja u istom frejmu se spajaju u jedno, simulacija vidi samo poslednju poziciju
+    if (glfwGetWindowUserPointer(window) == nullptr && !pendingInput.empty() && pendingInput.back().type == AquariumInput::Cursor)
+        pendingInput.back() = input;
+    else submitInput(window, input);
+}
+
+static void cursorEnterCallback(GLFWwindow* window, int entered)
+{
+    if (entered) return;
+    AquariumInput input;
+    input.type = AquariumInput::Cursor;
+    input.x = AQUARIUM_CURSOR_AWAY;
+    input.y = AQUARIUM_CURSOR_AWAY;
+    submitInput(window, input);
+}
+
+static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    //Ponavljanje drzanog tastera se ne snima, simulaciji su bitni samo pritisak i otpustanje
+    if (action == GLFW_REPEAT) return;
+    AquariumInput input;
+    input.type = AquariumInput::Key;
+    input.key = key;
+    input.action = action;
+    submitInput(window, input);
+}
+
+// Prozor je promijenio velicinu ili ga sistem trazi da se ponovo iscrta (crtanje na zahtjev)
+static bool windowDamaged = true;
+
+static void framebufferSizeCallback(GLFWwindow* window, int width, int height)
+{
+    windowDamaged = true;
+}
+
+static void windowRefreshCallback(GLFWwindow* window)
+{
+    windowDamaged = true;
+}
+
+static bool hasFlag(int argc, char** argv, const char* flag)
+{
+    for (int i = 1; i < argc; i++)
+        if (std::string(argv[i]) == flag) return true;
+    return false;
+}
+
+// Vrijednost iza opcije (npr. --fish-texture slika.png), ili nullptr ako opcije nema
+static const char* getOption(int argc, char** argv, const char* option)
+{
+    for (int i = 1; i + 1 < argc; i++)
+        if (std::string(argv[i]) == option) return argv[i + 1];
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    // Priprema tekstura unapred, bez otvaranja prozora: Kostur --bake-ktx2 <ulaz> <izlaz> [opcije]
+    if (argc >= 2 && std::string(argv[1]) == "--bake-ktx2") return runKtx2Baker(argc, argv);
+    // Ubrzanje sistema poslova sa 1..N niti: Kostur --job-bench
+    if (hasFlag(argc, argv, "--job-bench"))
+    {
+        printJobSystemBenchmark();
+        return 0;
+    }
+    // Jato preko mreze za 1k, 10k i 50k riba, naspram poredjenja svake ribe sa svakom: Kostur --boids-bench
+    if (hasFlag(argc, argv, "--boids-bench")) return printBoidsBenchmark() ? 0 : 1;
+    // Samo provjera SIMD verzija jata prema skalarnoj (izlaz 1 ako neka nije u granici): Kostur --boids-check
+    if (hasFlag(argc, argv, "--boids-check")) return checkBoidsKernels() ? 0 : 1;
+    // Brzina azuriranja riba kao objekata, niza struktura (AoS) i komponenti entiteta (SoA): Kostur --ecs-bench
+    if (hasFlag(argc, argv, "--ecs-bench"))
+    {
+        printEntityStoreBenchmark();
+        return 0;
+    }
 
-    GLFWwindow* window = glfwCreateWindow(800, 800, "Kostur", NULL, NULL);
+    // Crtanje bez ekrana u framebuffer zadate velicine: Kostur --headless [--size 1920x1080] [--frames 300] [--dump slika.ppm]
+    HeadlessOptions headless = parseHeadlessOptions(argc, argv);
+    // Snimanje ulaza (Kostur --record ulaz.bin [--seed 1234]) i reprodukcija najbrze sto moze (Kostur --replay ulaz.bin),
+    // sa vremenom simulacije i crtanja na kraju, za poredjenje verzija programa na istom poslu
+    InputLogOptions inputLog = parseInputLogOptions(argc, argv);
+    InputReplay replay;
+    bool replaying = !inputLog.replayPath.empty();
+    if (replaying && !replay.load(inputLog.replayPath.c_str())) return 1;
+    GLFWwindow* window;
+    if (headless.enabled) window = createHeadlessWindow();
+    else
+    {
+        glfwInit();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        window = glfwCreateWindow(800, 800, "Kostur", NULL, NULL);
+    }
     if (window == NULL) return endProgram("Prozor nije uspeo da se kreira.");
     glfwMakeContextCurrent(window);
+    // Tempo frejmova: Kostur --pacing vsync|adaptive|cap|low-latency|uncapped [--fps-cap 30]
+    // (simulacija svejedno ide fiksnim korakom); vremena frejmova se ispisuju na izlasku
+    FramePacer pacer;
+    double fpsCap;
+    FramePacingMode pacing = parseFramePacing(argc, argv, fpsCap);
+    pacer.init(headless.enabled || replaying ? FramePacingMode::Uncapped : pacing, fpsCap);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetCursorEnterCallback(window, cursorEnterCallback);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    glfwSetWindowRefreshCallback(window, windowRefreshCallback);
 
-    if (glewInit() != GLEW_OK) return endProgram("GLEW nije uspeo da se inicijalizuje.");
+    GLenum glewStatus = glewInit();
+    //Uz OSMesa nema GLX ekrana, ali su OpenGL funkcije vec ucitane
+    if (glewStatus != GLEW_OK && !(headless.enabled && glewStatus == GLEW_ERROR_NO_GLX_DISPLAY))
+        return endProgram("GLEW nije uspeo da se inicijalizuje.");
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Izvestaj o kvalitetu i brzini blok kompresije za jednu sliku: Kostur --bc-report slika.png (i uz --headless)
+    if (hasFlag(argc, argv, "--bc-report"))
+    {
+        const char* reportImage = getOption(argc, argv, "--bc-report");
+        if (reportImage != nullptr) printBlockCompressionReport(reportImage);
+        else std::cout << "Upotreba: " << argv[0] << " --bc-report slika.png" << std::endl;
+        glfwTerminate();
+        return reportImage != nullptr ? 0 : 1;
+    }
+
+    // Stanje se postavlja kroz kes, koji preskace pozive koji ne menjaju nista
+    glState().setEnabled(GL_BLEND, true);
+    glState().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     glClearColor(0.2f, 0.8f, 0.6f, 1.0f);
 
-    while (!glfwWindowShouldClose(window))
+    // Dekodovane (i blok kompresovane) teksture se cuvaju na disku, pa se od drugog pokretanja ne obradjuju ponovo
+    setTextureCacheDirectory("Cache/Textures");
+
+    // Linkovani sejder programi se takodje cuvaju na disku (kljuc ukljucuje drajver, pa nova verzija ponisti kes)
+    setProgramCacheDirectory("Cache/Programs");
+
+    // Objekti koji drze OpenGL resurse zive u ovom bloku, da se obrisu dok kontekst jos postoji
     {
-        glClear(GL_COLOR_BUFFER_BIT);
+        // Sejderi se ponovo ucitavaju cim se fajl snimi: Kostur --hot-reload (u Debug verziji uvijek)
+        ShaderRegistry shaders;
+#ifdef _DEBUG
+        shaders.setHotReload(true);
+#endif
+        if (hasFlag(argc, argv, "--hot-reload")) shaders.setHotReload(true);
+        // Vise akvarijuma u prozorima sa dijeljenim kontekstom: Kostur --windows 3 (sejderi i teksture se ucitavaju jednom).
+        // Niti dodatnih prozora citaju programe iz registra, pa se tada programi ne mijenjaju u toku rada.
+        int windowCount = headless.enabled || replaying ? 1 : parseWindowCount(argc, argv);
+        if (windowCount > 1 && shaders.isHotReloadEnabled())
+        {
+            std::cout << "Pracenje sejdera ne radi sa vise prozora, iskljuceno" << std::endl;
+            shaders.setHotReload(false);
+        }
+
+        // Vreme po prolazima na GPU: Kostur --gpu-profile (trake u uglu, brojevi u naslovu, CSV/JSON na izlasku)
+        bool gpuProfiling = hasFlag(argc, argv, "--gpu-profile");
+        GpuProfiler gpuProfiler;
+        GpuProfilerOverlay gpuOverlay;
+        if (gpuProfiling) gpuOverlay.create(shaders);
+        double lastTitleUpdate = 0;
+
+        // Podaci isti za sve programe (matrica, vreme, voda) idu u jedan uniform bafer, vezan jednom po frejmu
+        FrameUniforms frameUniforms;
+        frameUniforms.create();
+        FrameUniformData frameData = {};
+        setIdentityMatrix(frameData.viewProjection);
+        frameData.waterColor[0] = 0.2f;
+        frameData.waterColor[1] = 0.8f;
+        frameData.waterColor[2] = 0.6f;
+        frameData.waterColor[3] = 1.0f;
+        frameData.waterLevel = 0.6f;
+        frameData.waveAmplitude = 0.02f;
+        frameData.waveFrequency = 6.0f;
+        frameData.waveSpeed = 1.5f;
+
+        // Simulacija ide fiksnim korakom (Kostur --tick-rate 120), a ribe se crtaju interpolirane izmedju dva koraka.
+        // Simulacija radi u svojoj niti i salje snimke crtanju; Kostur --sim-inline je vraca u glavnu petlju.
+        // Reprodukcija uzima seme, broj riba i korak iz snimka.
+        bool simulationThread = !hasFlag(argc, argv, "--sim-inline") && !headless.enabled && !replaying;
+        unsigned seed = replaying ? replay.getSeed() : (inputLog.seed != 0 ? inputLog.seed : AQUARIUM_SEED);
+        int fishCount = replaying ? replay.getFishCount() : AQUARIUM_FISH;
+        double tickRate = replaying ? replay.getTickRate() : parseTickRate(argc, argv);
+        InputRecorder recorder;
+        bool recording = !inputLog.recordPath.empty();
+        if (recording) recorder.begin(seed, fishCount, tickRate);
+        SimulationThread simulation;
+        FrameScheduler scheduler(tickRate);
+        Aquarium aquarium;
+        if (simulationThread) simulation.start(fishCount, seed, tickRate, recording ? &recorder : nullptr);
+        else
+        {
+            aquarium.init(fishCount, seed);
+            if (recording) aquarium.setRecorder(&recorder);
+        }
+        std::vector<FishState> visibleFish;
+        FishRenderer fishRenderer;
+        fishRenderer.create(shaders, fishCount);
+
+        // Sare riba iz slike: Kostur --fish-texture slika.png [--texture-budget 256]. Teksture se ucitavaju kroz menadzer
+        // rezidentnosti (i kes tekstura, pa se slika od drugog pokretanja ne dekoduje). Tekstura je zajednicka za sve
+        // prozore (dijeljeni kontekst); niti dodatnih prozora ne prolaze kroz menadzer, pa je tada zakucana.
+        TextureResidency textures(parseTextureBudget(argc, argv));
+        const char* fishTexturePath = getOption(argc, argv, "--fish-texture");
+        unsigned fishTextureHandle = fishTexturePath != nullptr ? textures.add(fishTexturePath) : 0;
+        unsigned fishTexture = 0;
+        if (fishTexturePath != nullptr)
+        {
+            if (windowCount > 1) textures.setPinned(fishTextureHandle, true);
+            fishTexture = textures.use(fishTextureHandle);
+        }
+        printTextureCacheReport();
+
+        // Svaki dodatni akvarijum ima svoje seme, simulaciju i nit crtanja
+        std::vector<std::unique_ptr<AquariumWindow>> extraWindows;
+        for (int i = 1; i < windowCount; i++)
+        {
+            std::unique_ptr<AquariumWindow> extra(new AquariumWindow());
+            if (!extra->create(window, shaders, i, fishCount, seed + i, tickRate, frameData))
+            {
+                extra->stop();
+                continue;
+            }
+            extra->setFishTexture(fishTexture);
+            glfwSetMouseButtonCallback(extra->getWindow(), mouseButtonCallback);
+            glfwSetCursorPosCallback(extra->getWindow(), cursorPosCallback);
+            glfwSetCursorEnterCallback(extra->getWindow(), cursorEnterCallback);
+            glfwSetKeyCallback(extra->getWindow(), keyCallback);
+            extraWindows.push_back(std::move(extra));
+        }
+
+        // Crtanje samo kad se nesto promijeni, a mirna scena ambijentalnom brzinom: Kostur --on-demand [--ambient-fps 10]
+        // (iskoriscenost procesora se ispisuje na izlasku u oba nacina, za poredjenje)
+        RedrawScheduler redraw;
+        redraw.init(hasFlag(argc, argv, "--on-demand") && !headless.enabled && !replaying, parseAmbientFps(argc, argv));
+        //Nit simulacije tada ne otkucava izmedju frejmova, nego napreduje tek kad crtanje zatrazi snimak
+        simulation.setOnDemand(redraw.isOnDemand());
+
+        // Scena se crta u smanjenoj rezoluciji koja prati vrijeme frejma, pa se uvecava u prozor:
+        // Kostur --dynamic-res [--res-min 0.5] [--res-max 1.0] [--res-fps 60] [--sharpen 0.5]
+        DynamicResolutionOptions dynamicOptions = parseDynamicResolution(argc, argv);
+        DynamicResolution dynamicResolution;
+        if (dynamicOptions.enabled && !dynamicResolution.create(shaders, dynamicOptions, pacer.getTargetFps())) dynamicOptions.enabled = false;
+        // Svi programi su dodati (i oni iz dodatnih prozora), pa izvjestaj kesa programa obuhvata svaki
+        printProgramCacheReport();
+
+        // Niti dodatnih prozora citaju registar bez zakljucavanja, pa se pokrecu tek kad su svi programi dodati
+        if (!extraWindows.empty())
+        {
+            shaders.freeze();
+            for (std::unique_ptr<AquariumWindow>& extra : extraWindows) extra->start();
+        }
+
+        RenderTarget headlessTarget;
+        if (headless.enabled && !headlessTarget.create(headless.width, headless.height)) glfwSetWindowShouldClose(window, GLFW_TRUE);
+        double headlessStart = glfwGetTime();
+        double simulationSeconds = 0;
+
+        while (!glfwWindowShouldClose(window) && !(headless.enabled && !replaying && redraw.getStats().rendered >= (unsigned long long)headless.frames)
+            && !(replaying && replay.isFinished(aquarium)))
+        {
+            //Bez ekrana i pri reprodukciji vrijeme tece tacno jedan korak simulacije po frejmu, pa je svako pokretanje isto.
+            //Inace se sat cita tek posle cekanja na pocetak frejma i na dogadjaje, da simulacija ne kasni za cekanjem.
+            bool fixedClock = headless.enabled || replaying;
+            pacer.waitForFrameStart();
+            redraw.waitForEvents(fixedClock ? redraw.getStats().rendered * scheduler.getTickSeconds() : glfwGetTime());
+            double now = fixedClock ? redraw.getStats().rendered * scheduler.getTickSeconds() : glfwGetTime();
+            for (std::unique_ptr<AquariumWindow>& extra : extraWindows)
+                if (extra->shouldClose()) extra->stop();
+            unsigned reloads = shaders.getReloadCount();
+            shaders.update();
+            if (!pendingInput.empty() || windowDamaged || shaders.getReloadCount() != reloads)
+            {
+                redraw.markDirty();
+                windowDamaged = false;
+            }
+            if (!redraw.shouldRender(now)) continue;
+            glState().beginFrame();
+            textures.beginFrame();
+            if (fishTexturePath != nullptr) fishRenderer.setTexture(textures.use(fishTextureHandle));
+
+            int framebufferWidth, framebufferHeight;
+            if (headless.enabled)
+            {
+                headlessTarget.bind();
+                framebufferWidth = headless.width;
+                framebufferHeight = headless.height;
+            }
+            else glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            GLuint outputFramebuffer = headless.enabled ? headlessTarget.getFramebuffer() : 0;
+            int renderWidth = framebufferWidth, renderHeight = framebufferHeight;
+            if (dynamicOptions.enabled)
+            {
+                dynamicResolution.beginFrame(outputFramebuffer, framebufferWidth, framebufferHeight);
+                renderWidth = dynamicResolution.getRenderWidth();
+                renderHeight = dynamicResolution.getRenderHeight();
+            }
+            float time = (float)now;
+            frameData.deltaTime = time - frameData.time;
+            frameData.time = time;
+            frameData.resolution[0] = (float)renderWidth;
+            frameData.resolution[1] = (float)renderHeight;
+            frameUniforms.update(frameData);
+
+            const std::vector<FoodState>* visibleFood;
+            if (simulationThread)
+            {
+                for (const AquariumInput& input : pendingInput) simulation.pushInput(input);
+                pendingInput.clear();
+                simulation.requestSnapshot();
+                const AquariumSnapshot& snapshot = simulation.acquireSnapshot();
+                interpolateFish(snapshot.previous, snapshot.current, simulation.getAlpha(snapshot), visibleFish);
+                visibleFood = &snapshot.food;
+            }
+            else if (replaying)
+            {
+                //Ulaz sa tastature i misa se ignorise, simulacija dobija samo snimljene dogadjaje
+                pendingInput.clear();
+                double simulationStart = glfwGetTime();
+                replay.applyDue(aquarium);
+                aquarium.step((float)scheduler.getTickSeconds());
+                simulationSeconds += glfwGetTime() - simulationStart;
+                visibleFish = aquarium.getFish();
+                visibleFood = &aquarium.getFood();
+            }
+            else
+            {
+                int ticks = scheduler.advanceTo(now);
+                if (ticks > 0)
+                {
+                    for (const AquariumInput& input : pendingInput) aquarium.apply(input);
+                    pendingInput.clear();
+                }
+                for (int i = 0; i < ticks; i++) aquarium.step((float)scheduler.getTickSeconds());
+                interpolateFish(aquarium.getPreviousFish(), aquarium.getFish(), scheduler.getAlpha(), visibleFish);
+                visibleFood = &aquarium.getFood();
+            }
+
+            //Dok ima hrane u vodi ribe se brzo okrecu, pa se crta punom brzinom
+            redraw.setActive(!visibleFood->empty() || gpuProfiling);
+            if (gpuProfiling) gpuProfiler.beginFrame();
+            {
+                GpuScope scope(gpuProfiler, "clear");
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+            {
+                GpuScope scope(gpuProfiler, "ribe");
+                fishRenderer.draw(visibleFish, *visibleFood);
+            }
+            if (dynamicOptions.enabled)
+            {
+                GpuScope scope(gpuProfiler, "uvecanje");
+                dynamicResolution.endFrame();
+            }
+
+            if (gpuProfiling)
+            {
+                std::vector<GpuPassStats> stats = gpuProfiler.getStats();
+                {
+                    GpuScope scope(gpuProfiler, "overlay");
+                    gpuOverlay.draw(stats);
+                }
+                if (glfwGetTime() - lastTitleUpdate > 0.5)
+                {
+                    glfwSetWindowTitle(window, GpuProfilerOverlay::formatSummary(stats).c_str());
+                    lastTitleUpdate = glfwGetTime();
+                }
+                gpuProfiler.endFrame();
+            }
+
+            frameUniforms.endFrame();
+            pacer.beforeSwap();
+            if (!headless.enabled) glfwSwapBuffers(window);
+            pacer.afterSwap();
+            redraw.frameRendered(glfwGetTime());
+        }
+        for (std::unique_ptr<AquariumWindow>& extra : extraWindows)
+        {
+            extra->stop();
+            extra->printReport();
+        }
+        pacer.printReport();
+        redraw.printReport();
+        if (fishTexturePath != nullptr) textures.printReport();
+        if (dynamicOptions.enabled) dynamicResolution.printReport();
+
+        if (replaying)
+        {
+            glFinish();
+            double seconds = glfwGetTime() - headlessStart;
+            unsigned long long ticks = aquarium.getTick() > 0 ? aquarium.getTick() : 1;
+            std::cout << "Reprodukcija: " << ticks << " koraka, " << replay.getEventCount() << " dogadjaja, simulacija "
+                << simulationSeconds * 1000.0 << " ms (" << simulationSeconds * 1000.0 / ticks << " ms po koraku), crtanje "
+                << (seconds - simulationSeconds) * 1000.0 << " ms (" << (seconds - simulationSeconds) * 1000.0 / ticks
+                << " ms po frejmu), ukupno " << seconds << " s, kontrolni zbir " << std::hex << aquariumChecksum(aquarium)
+                << std::dec << std::endl;
+            if (!replay.isFinished(aquarium)) std::cout << "Reprodukcija je prekinuta prije kraja snimka" << std::endl;
+        }
+
+        if (headless.enabled && headlessTarget.getFramebuffer() != 0)
+        {
+            glFinish();
+            double seconds = glfwGetTime() - headlessStart;
+            unsigned long long frames = redraw.getStats().rendered;
+            std::cout << "Bez ekrana: " << frames << " frejmova " << headless.width << "x" << headless.height << " za " << seconds
+                << " s (" << seconds * 1000.0 / frames << " ms po frejmu, " << frames / seconds << " fps)" << std::endl;
+            std::vector<unsigned char> pixels;
+            if (!headless.dumpPath.empty() && headlessTarget.readPixels(pixels)
+                && writePpm(headless.dumpPath.c_str(), pixels.data(), headless.width, headless.height))
+                std::cout << "Poslednji frejm upisan u " << headless.dumpPath << std::endl;
+        }
+        headlessTarget.destroy();
+        dynamicResolution.destroy();
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        if (gpuProfiling)
+        {
+            gpuProfiler.writeCsv("gpu_profile.csv");
+            gpuProfiler.writeJson("gpu_profile.json");
+            gpuOverlay.destroy();
+        }
+        simulation.stop();
+        if (recording)
+        {
+            const Aquarium& recorded = simulationThread ? simulation.getAquarium() : aquarium;
+            if (recorder.save(inputLog.recordPath.c_str(), recorded.getTick()))
+                std::cout << "Snimak ulaza: " << recorder.getEventCount() << " dogadjaja, " << recorded.getTick() << " koraka, upisan u "
+                    << inputLog.recordPath << " (kontrolni zbir " << std::hex << aquariumChecksum(recorded) << std::dec << ")" << std::endl;
+        }
+        fishRenderer.destroy();
+        textures.evictAll();
+        frameUniforms.destroy();
     }
 
     glfwDestroyWindow(window);
@@ -0,0 +1,108 @@
+#include "../Header/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Opis: mapiranje fajlova u memoriju za kes tekstura i kontejnere sa vec pripremljenim teksturama
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const char* filePath)
+{
+    close();
+    HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    opened = true;
+    length = (size_t)fileSize.QuadPart;
+    if (length == 0) return true; //Prazan fajl se ne moze mapirati, ali nije greska
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+    bytes = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (bytes == nullptr)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (bytes != nullptr) UnmapViewOfFile(bytes);
+    if (mappingHandle != nullptr) CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle != nullptr) CloseHandle((HANDLE)fileHandle);
+    bytes = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+bool MappedFile::open(const char* filePath)
+{
+    close();
+    int fd = ::open(filePath, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    opened = true;
+    length = (size_t)info.st_size;
+    if (length > 0)
+    {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            ::close(fd);
+            opened = false;
+            length = 0;
+            return false;
+        }
+        bytes = (const unsigned char*)mapped;
+    }
+    ::close(fd); //Mapa ostaje validna i nakon zatvaranja deskriptora
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (bytes != nullptr) munmap((void*)bytes, length);
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
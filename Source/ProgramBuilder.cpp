@@ -0,0 +1,175 @@
+#include "../Header/ProgramBuilder.h"
+
+#include <chrono>
+#include <iostream>
+
+#include "../Header/GLStateCache.h"
+#include "../Header/ProgramCache.h"
+#include "../Header/ShaderPreprocessor.h"
+
+// Opis: asinhrono prevodjenje i linkovanje sejder programa (GL_KHR_parallel_shader_compile), provjerava se svaki frejm
+
+static double secondsNow()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ProgramBuilder::ProgramBuilder()
+{
+    parallel = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+    //Drajver sam bira broj niti za prevodjenje
+    if (GLEW_KHR_parallel_shader_compile) glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    else if (GLEW_ARB_parallel_shader_compile) glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+}
+
+ProgramBuilder::~ProgramBuilder()
+{
+    for (Build& build : builds)
+    {
+        if (build.state != ProgramBuildState::Pending) continue;
+        glDeleteShader(build.vertexShader);
+        glDeleteShader(build.fragmentShader);
+        glState().deleteProgram(build.program);
+    }
+}
+
+int ProgramBuilder::submit(const char* vsSource, const char* fsSource, const std::string& defines)
+{
+    std::string vsCode, fsCode;
+    preprocessShaderFile(vsSource, defines, vsCode);
+    preprocessShaderFile(fsSource, defines, fsCode);
+    return submitCode(std::string(vsSource) + "|" + fsSource + "|" + defines, vsCode, fsCode, defines);
+}
+
+int ProgramBuilder::submitCode(const std::string& name, const std::string& vsCode, const std::string& fsCode, const std::string& defines)
+{
+    Build build;
+    build.name = name;
+    build.submitTime = secondsNow();
+    stats.submitted++;
+
+    if (isProgramCacheEnabled())
+    {
+        //Program iz kesa je spreman odmah, glProgramBinary ne prevodi nista
+        build.cacheKey = programCacheKey(vsCode, fsCode, defines);
+        build.program = loadCachedProgram(name, build.cacheKey);
+        if (build.program != 0)
+        {
+            build.state = ProgramBuildState::Ready;
+            stats.fromCache++;
+            stats.ready++;
+            builds.push_back(build);
+            return (int)builds.size() - 1;
+        }
+    }
+
+    //Sve se samo predaje drajveru; nijedan status se ne cita dok poll ne vidi da je program gotov
+    const char* vertexCode = vsCode.c_str();
+    const char* fragmentCode = fsCode.c_str();
+    build.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(build.vertexShader, 1, &vertexCode, NULL);
+    glCompileShader(build.vertexShader);
+    build.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(build.fragmentShader, 1, &fragmentCode, NULL);
+    glCompileShader(build.fragmentShader);
+
+    build.program = glCreateProgram();
+    if (isProgramCacheEnabled()) glProgramParameteri(build.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(build.program, build.vertexShader);
+    glAttachShader(build.program, build.fragmentShader);
+    glLinkProgram(build.program);
+
+    builds.push_back(build);
+    pendingCount++;
+    return (int)builds.size() - 1;
+}
+
+bool ProgramBuilder::isComplete(const Build& build) const
+{
+    if (!parallel) return true;
+    GLint done = GL_FALSE;
+    glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
+
+static void printShaderLog(GLuint shader, const char* type)
+{
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled == GL_TRUE) return;
+    char infoLog[512];
+    glGetShaderInfoLog(shader, 512, NULL, infoLog);
+    std::cout << type << " sejder ima gresku! Greska: \n" << infoLog << std::endl;
+}
+
+void ProgramBuilder::complete(Build& build)
+{
+    GLint linked = GL_FALSE;
+    glGetProgramiv(build.program, GL_LINK_STATUS, &linked);
+    if (linked == GL_TRUE)
+    {
+        build.state = ProgramBuildState::Ready;
+        stats.ready++;
+        storeCachedProgram(build.name, build.cacheKey, build.program, secondsNow() - build.submitTime);
+    }
+    else
+    {
+        std::cout << "Program \"" << build.name << "\" nije uspio da se napravi." << std::endl;
+        printShaderLog(build.vertexShader, "VERTEX");
+        printShaderLog(build.fragmentShader, "FRAGMENT");
+        char infoLog[512];
+        glGetProgramInfoLog(build.program, 512, NULL, infoLog);
+        std::cout << "Objedinjeni sejder ima gresku! Greska: \n" << infoLog << std::endl;
+        glState().deleteProgram(build.program);
+        build.program = 0;
+        build.state = ProgramBuildState::Failed;
+        stats.failed++;
+    }
+
+    if (build.program != 0)
+    {
+        glDetachShader(build.program, build.vertexShader);
+        glDetachShader(build.program, build.fragmentShader);
+    }
+    glDeleteShader(build.vertexShader);
+    glDeleteShader(build.fragmentShader);
+    build.vertexShader = build.fragmentShader = 0;
+    pendingCount--;
+}
+
+int ProgramBuilder::poll(int maxBlockingPerPoll)
+{
+    int completed = 0;
+    for (Build& build : builds)
+    {
+        if (pendingCount == 0) break;
+        if (build.state != ProgramBuildState::Pending) continue;
+        if (!parallel && completed >= maxBlockingPerPoll) break;
+        if (!isComplete(build))
+        {
+            stats.pollsWaiting++;
+            continue;
+        }
+        complete(build);
+        completed++;
+    }
+    return completed;
+}
+
+void ProgramBuilder::finish()
+{
+    for (Build& build : builds)
+        if (build.state == ProgramBuildState::Pending) complete(build);
+}
+
+ProgramBuildState ProgramBuilder::getState(int handle) const
+{
+    if (handle < 0 || handle >= (int)builds.size()) return ProgramBuildState::Failed;
+    return builds[handle].state;
+}
+
+unsigned ProgramBuilder::getProgram(int handle) const
+{
+    if (getState(handle) != ProgramBuildState::Ready) return 0;
+    return builds[handle].program;
+}
@@ -0,0 +1,208 @@
+#include "../Header/ProgramCache.h"
+
+#include <GL/glew.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+
+// Opis: kes binarnih sejder programa na disku, da se programi ne prevode pri svakom pokretanju
+
+namespace fs = std::filesystem;
+
+static const char CACHE_MAGIC[4] = { 'K', 'P', 'C', '1' };
+static const unsigned int CACHE_VERSION = 1;
+
+struct CachedProgramHeader {
+    char magic[4];
+    unsigned int version;
+    unsigned long long key;
+    unsigned long long binaryHash; // Hes binarnog programa, da se odsjecen ili izmijenjen fajl ne salje drajveru
+    unsigned int format; // binaryFormat iz glGetProgramBinary
+    unsigned int length;
+};
+
+static std::string cacheDirectory;
+static ProgramCacheStats stats;
+
+static bool isProgramBinarySupported()
+{
+    if (!GLEW_ARB_get_program_binary) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+void setProgramCacheDirectory(const std::string& directory)
+{
+    cacheDirectory = directory;
+    if (cacheDirectory.empty()) return;
+
+    if (!isProgramBinarySupported())
+    {
+        std::cout << "Kes sejdera nije ukljucen, drajver ne podrzava binarne programe." << std::endl;
+        cacheDirectory.clear();
+        return;
+    }
+    std::error_code error;
+    fs::create_directories(cacheDirectory, error);
+    if (error)
+    {
+        std::cout << "Kes sejdera nije ukljucen, ne moze se napraviti folder \"" << cacheDirectory << "\"!" << std::endl;
+        cacheDirectory.clear();
+    }
+}
+
+bool isProgramCacheEnabled()
+{
+    return !cacheDirectory.empty();
+}
+
+const ProgramCacheStats& getProgramCacheStats()
+{
+    return stats;
+}
+
+unsigned long long programCacheKey(const std::string& vertexCode, const std::string& fragmentCode, const std::string& defines)
+{
+    //Binarni program vazi samo za isti drajver, pa njegovi stringovi ulaze u kljuc
+    unsigned long long key = CACHE_VERSION;
+    const GLenum driverStrings[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    for (GLenum name : driverStrings)
+    {
+        const char* value = (const char*)glGetString(name);
+        key = hashString(value != nullptr ? value : "", key);
+    }
+    key = hashString(vertexCode, key);
+    key = hashString(fragmentCode, key);
+    return hashString(defines, key);
+}
+
+static std::string entryPrefix(const std::string& name)
+{
+    return hashToHex(hashString(name)) + "-";
+}
+
+static std::string entryPath(const std::string& name, unsigned long long key)
+{
+    return (fs::path(cacheDirectory) / (entryPrefix(name) + hashToHex(key) + ".prog")).string();
+}
+
+static unsigned programFromEntry(const MappedFile& entry, unsigned long long key)
+{
+    if (entry.size() < sizeof(CachedProgramHeader)) return 0;
+    CachedProgramHeader header;
+    memcpy(&header, entry.data(), sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, 4) != 0 || header.version != CACHE_VERSION || header.key != key) return 0;
+    if (header.length == 0 || sizeof(header) + header.length > entry.size()) return 0;
+    const unsigned char* binary = entry.data() + sizeof(header);
+    if (hashBytes(binary, header.length) != header.binaryHash) return 0;
+
+    unsigned program = glCreateProgram();
+    glProgramBinary(program, header.format, binary, (GLsizei)header.length);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+unsigned loadCachedProgram(const std::string& name, unsigned long long key)
+{
+    if (!isProgramCacheEnabled()) return 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::string path = entryPath(name, key);
+    unsigned program = 0;
+    {
+        MappedFile entry;
+        if (!entry.open(path.c_str())) return 0;
+        program = programFromEntry(entry, key);
+    }
+    if (program == 0)
+    {
+        //Drajver je odbio program (npr. promijenjen kompajler iste verzije) ili je unos ostecen
+        stats.rejected++;
+        std::error_code error;
+        fs::remove(path, error);
+        return 0;
+    }
+
+    stats.hits++;
+    stats.hitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return program;
+}
+
+static void removeStaleEntries(const std::string& prefix, const std::string& currentName)
+{
+    //Stari unosi istog programa (prije izmjene sejdera ili drajvera) vise nikad nece biti pogodjeni
+    std::error_code error;
+    for (const fs::directory_entry& file : fs::directory_iterator(cacheDirectory, error))
+    {
+        std::string fileName = file.path().filename().string();
+        if (fileName != currentName && fileName.compare(0, prefix.size(), prefix) == 0)
+            fs::remove(file.path(), error);
+    }
+}
+
+void storeCachedProgram(const std::string& name, unsigned long long key, unsigned program, double buildSeconds)
+{
+    if (!isProgramCacheEnabled() || program == 0) return;
+    auto start = std::chrono::steady_clock::now();
+    stats.misses++;
+    stats.missSeconds += buildSeconds;
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked == GL_FALSE) return; //Neuspjesan program se ne pamti, da bi se greska ponovo prijavila
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<unsigned char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+    if (length <= 0) return;
+
+    CachedProgramHeader header;
+    memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.binaryHash = hashBytes(binary.data(), (size_t)length);
+    header.format = format;
+    header.length = (unsigned)length;
+
+    //Pisemo u privremeni fajl pa ga preimenujemo, da drugi proces nikad ne vidi pola upisan unos
+    std::string path = entryPath(name, key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return;
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)binary.data(), length);
+        if (!file.good()) return;
+    }
+    std::error_code error;
+    fs::rename(tempPath, path, error);
+    if (error) fs::remove(tempPath, error);
+    removeStaleEntries(entryPrefix(name), fs::path(path).filename().string());
+
+    stats.missSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printProgramCacheReport()
+{
+    if (stats.hits + stats.misses == 0) return;
+    std::cout << "Kes sejdera: " << stats.hits << " iz kesa (" << stats.hitSeconds * 1000.0 << " ms, toplo), "
+        << stats.misses << " prevedeno (" << stats.missSeconds * 1000.0 << " ms, hladno)";
+    if (stats.rejected > 0) std::cout << ", " << stats.rejected << " odbijeno";
+    std::cout << std::endl;
+}
@@ -0,0 +1,103 @@
+#include "../Header/RedrawScheduler.h"
+
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Opis: crtanje na zahtjev (prljavi frejmovi, smanjena ambijentalna brzina) i mjerenje iskoriscenosti procesora
+
+static double wallSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double processCpuSeconds()
+{
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return 0;
+    ULARGE_INTEGER kernelTime, userTime;
+    kernelTime.LowPart = kernel.dwLowDateTime;
+    kernelTime.HighPart = kernel.dwHighDateTime;
+    userTime.LowPart = user.dwLowDateTime;
+    userTime.HighPart = user.dwHighDateTime;
+    return (kernelTime.QuadPart + userTime.QuadPart) * 1e-7; //Jedinica je 100 ns
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) return 0;
+    return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+}
+
+void RedrawScheduler::init(bool onDemandMode, double ambientFps)
+{
+    onDemand = onDemandMode;
+    ambientInterval = ambientFps > 0 ? 1.0 / ambientFps : 1e9;
+    nextAmbientFrame = 0;
+    dirty = true;
+    active = false;
+    stats = RedrawStats();
+    startWall = wallSeconds();
+    startCpu = processCpuSeconds();
+}
+
+void RedrawScheduler::waitForEvents(double now)
+{
+    if (!onDemand || dirty || active)
+    {
+        glfwPollEvents();
+        return;
+    }
+    double timeout = nextAmbientFrame - now;
+    if (timeout <= 0)
+    {
+        glfwPollEvents();
+        return;
+    }
+    //Budi se na prvi dogadjaj (ulaz, promjena prozora) ili kad dodje vrijeme za sledeci ambijentalni frejm
+    double start = wallSeconds();
+    glfwWaitEventsTimeout(timeout);
+    stats.waitedSeconds += wallSeconds() - start;
+}
+
+bool RedrawScheduler::shouldRender(double now)
+{
+    if (!onDemand || dirty || active || now >= nextAmbientFrame) return true;
+    stats.wakeups++;
+    return false;
+}
+
+void RedrawScheduler::frameRendered(double now)
+{
+    stats.rendered++;
+    dirty = false;
+    nextAmbientFrame = now + ambientInterval;
+}
+
+void RedrawScheduler::printReport() const
+{
+    double wall = wallSeconds() - startWall;
+    double cpu = processCpuSeconds() - startCpu;
+    if (wall <= 0) return;
+    std::cout << "Procesor (" << (onDemand ? "na zahtjev" : "svaki frejm") << "): " << cpu << " s za " << wall << " s ("
+        << cpu / wall * 100.0 << "% jednog jezgra), " << stats.rendered << " frejmova (" << stats.rendered / wall << " fps)";
+    if (onDemand) std::cout << ", " << stats.wakeups << " budjenja bez crtanja, " << stats.waitedSeconds << " s u cekanju";
+    std::cout << std::endl;
+}
+
+double parseAmbientFps(int argc, char** argv)
+{
+    for (int i = 1; i + 1 < argc; i++)
+        if (std::string(argv[i]) == "--ambient-fps") return std::atof(argv[i + 1]);
+    return 10.0;
+}
@@ -0,0 +1,94 @@
+#include "../Header/RenderTarget.h"
+
+#include <fstream>
+#include <iostream>
+
+#include "../Header/GLStateCache.h"
+
+// Opis: crtanje u teksturu umjesto u prozor i upis slike framebuffer-a na disk
+
+RenderTarget::~RenderTarget()
+{
+    destroy();
+}
+
+bool RenderTarget::create(int newWidth, int newHeight)
+{
+    destroy();
+    if (newWidth <= 0 || newHeight <= 0) return false;
+    width = newWidth;
+    height = newHeight;
+
+    glGenTextures(1, &texture);
+    glState().bindTextureUnit(0, GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &framebuffer);
+    glState().bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glState().bindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "Framebuffer " << width << "x" << height << " nije kompletan (0x" << std::hex << status << std::dec << ")" << std::endl;
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void RenderTarget::destroy()
+{
+    if (framebuffer != 0) glState().deleteFramebuffer(framebuffer);
+    if (texture != 0) glState().deleteTexture(texture);
+    framebuffer = 0;
+    texture = 0;
+    width = 0;
+    height = 0;
+}
+
+void RenderTarget::bind()
+{
+    glState().bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glState().viewport(0, 0, width, height);
+}
+
+bool RenderTarget::readPixels(std::vector<unsigned char>& rgba)
+{
+    if (framebuffer == 0) return false;
+    rgba.resize((size_t)width * height * 4);
+    glState().bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glState().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    return glGetError() == GL_NO_ERROR;
+}
+
+bool writePpm(const char* filePath, const unsigned char* rgba, int width, int height)
+{
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+    {
+        std::cout << "Fajl \"" << filePath << "\" nije otvoren za upis" << std::endl;
+        return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    //PPM pocinje od gornjeg reda, a OpenGL od donjeg
+    std::vector<unsigned char> row((size_t)width * 3);
+    for (int y = height - 1; y >= 0; y--)
+    {
+        const unsigned char* source = rgba + (size_t)y * width * 4;
+        for (int x = 0; x < width; x++)
+        {
+            row[x * 3 + 0] = source[x * 4 + 0];
+            row[x * 3 + 1] = source[x * 4 + 1];
+            row[x * 3 + 2] = source[x * 4 + 2];
+        }
+        file.write((const char*)row.data(), row.size());
+    }
+    return (bool)file;
+}
@@ -0,0 +1,130 @@
+#include "../Header/ShaderPreprocessor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+#include "../Header/ShaderSources.h"
+
+// Opis: #include i ubacivanje definicija u GLSL kod, prije prevodjenja sejdera
+
+namespace fs = std::filesystem;
+
+struct PreprocessState {
+    std::vector<std::string> files;
+    std::string defines;
+    bool versionSeen = false;
+};
+
+static bool directiveArgument(const std::string& line, const char* directive, std::string& argument)
+{
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line[start] != '#') return false;
+    size_t name = line.find_first_not_of(" \t", start + 1);
+    size_t length = strlen(directive);
+    if (name == std::string::npos || line.compare(name, length, directive) != 0) return false;
+    argument = line.substr(name + length);
+    return true;
+}
+
+static bool processCode(const std::string& normalized, const std::string& code, PreprocessState& state, std::ostringstream& output);
+
+static bool processFile(const std::string& filePath, PreprocessState& state, std::ostringstream& output)
+{
+    std::string normalized = fs::path(filePath).lexically_normal().generic_string();
+    std::string code;
+    if (!loadShaderSource(normalized, code)) return false;
+    return processCode(normalized, code, state, output);
+}
+
+static bool processCode(const std::string& normalized, const std::string& code, PreprocessState& state, std::ostringstream& output)
+{
+    int sourceIndex = (int)state.files.size();
+    state.files.push_back(normalized);
+    fs::path directory = fs::path(normalized).parent_path();
+
+    std::istringstream lines(code);
+    std::string line, argument;
+    int lineNumber = 0;
+    while (std::getline(lines, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        if (directiveArgument(line, "version", argument))
+        {
+            if (state.versionSeen)
+            {
+                //#version u ukljucenom fajlu se izbacuje, vazi samo onaj iz glavnog sejdera
+                output << "\n";
+                continue;
+            }
+            state.versionSeen = true;
+            output << line << "\n" << state.defines;
+            output << "#line " << lineNumber + 1 << " " << sourceIndex << "\n";
+            continue;
+        }
+
+        if (directiveArgument(line, "include", argument))
+        {
+            size_t open = argument.find('"');
+            size_t close = open == std::string::npos ? open : argument.find('"', open + 1);
+            if (close == std::string::npos)
+            {
+                std::cout << "Neispravan #include u \"" << normalized << "\", linija " << lineNumber << std::endl;
+                return false;
+            }
+            std::string included = (directory / argument.substr(open + 1, close - open - 1)).lexically_normal().generic_string();
+            if (std::find(state.files.begin(), state.files.end(), included) != state.files.end())
+            {
+                output << "\n"; //Vec ubacen
+                continue;
+            }
+            output << "#line 1 " << state.files.size() << "\n";
+            if (!processFile(included, state, output))
+            {
+                std::cout << "Fajl ukljucen iz \"" << normalized << "\", linija " << lineNumber << std::endl;
+                return false;
+            }
+            output << "#line " << lineNumber + 1 << " " << sourceIndex << "\n";
+            continue;
+        }
+
+        output << line << "\n";
+    }
+    return true;
+}
+
+bool preprocessShaderFile(const std::string& filePath, const std::string& defines, std::string& output,
+    std::vector<std::string>* includedFiles)
+{
+    PreprocessState state;
+    state.defines = defines;
+    std::ostringstream result;
+    bool success = processFile(filePath, state, result);
+    if (includedFiles != nullptr) *includedFiles = state.files;
+    output = success ? result.str() : std::string();
+    return success;
+}
+
+bool preprocessShaderCode(const std::string& name, const std::string& code, const std::string& defines, std::string& output,
+    std::vector<std::string>* includedFiles)
+{
+    PreprocessState state;
+    state.defines = defines;
+    std::ostringstream result;
+    bool success = processCode(fs::path(name).lexically_normal().generic_string(), code, state, result);
+    if (includedFiles != nullptr) *includedFiles = state.files;
+    output = success ? result.str() : std::string();
+    return success;
+}
+
+std::string featureDefines(unsigned features, const std::vector<std::string>& featureNames)
+{
+    std::string defines;
+    for (size_t bit = 0; bit < featureNames.size() && bit < 32; bit++)
+        if (features & (1u << bit)) defines += "#define " + featureNames[bit] + " 1\n";
+    return defines;
+}
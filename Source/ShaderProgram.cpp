@@ -0,0 +1,110 @@
+#include "../Header/ShaderProgram.h"
+
+#include <iostream>
+
+#include "../Header/FrameUniforms.h"
+#include "../Header/Util.h"
+
+// Opis: citanje aktivnih uniformi, atributa i uniform blokova programa posle linkovanja
+
+static std::string arrayBaseName(const std::string& name)
+{
+    //Nizovi se prijavljuju kao "ime[0]", a trazi se i samo "ime"
+    size_t bracket = name.find('[');
+    return bracket == std::string::npos ? name : name.substr(0, bracket);
+}
+
+void ShaderProgram::reflect(unsigned program)
+{
+    id = program;
+    uniforms.clear();
+    attributes.clear();
+    blocks.clear();
+    uniformLocations.clear();
+    attributeLocations.clear();
+    if (program == 0) return;
+
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; i++)
+    {
+        ShaderVariable uniform;
+        GLsizei length = 0;
+        glGetActiveUniform(program, (GLuint)i, (GLsizei)name.size(), &length, &uniform.size, &uniform.type, name.data());
+        uniform.name.assign(name.data(), length);
+        uniform.location = glGetUniformLocation(program, uniform.name.c_str());
+        uniforms.push_back(uniform);
+        if (uniform.location < 0) continue; //Clan uniform bloka
+        uniformLocations[uniform.name] = uniform.location;
+        uniformLocations[arrayBaseName(uniform.name)] = uniform.location;
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+    name.resize(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; i++)
+    {
+        ShaderVariable attribute;
+        GLsizei length = 0;
+        glGetActiveAttrib(program, (GLuint)i, (GLsizei)name.size(), &length, &attribute.size, &attribute.type, name.data());
+        attribute.name.assign(name.data(), length);
+        attribute.location = glGetAttribLocation(program, attribute.name.c_str());
+        attributes.push_back(attribute);
+        attributeLocations[attribute.name] = attribute.location;
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+    name.resize(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; i++)
+    {
+        ShaderBlock block;
+        GLsizei length = 0;
+        block.index = (GLuint)i;
+        glGetActiveUniformBlockName(program, block.index, (GLsizei)name.size(), &length, name.data());
+        block.name.assign(name.data(), length);
+        glGetActiveUniformBlockiv(program, block.index, GL_UNIFORM_BLOCK_DATA_SIZE, &block.dataSize);
+        //Svi programi citaju podatke frejma sa iste tacke vezivanja, pa se bafer vezuje jednom po frejmu
+        if (block.name == FRAME_UNIFORM_BLOCK) glUniformBlockBinding(program, block.index, FRAME_UNIFORM_BINDING);
+        glGetActiveUniformBlockiv(program, block.index, GL_UNIFORM_BLOCK_BINDING, &block.binding);
+        blocks.push_back(block);
+    }
+}
+
+GLint ShaderProgram::getUniformLocation(const std::string& name) const
+{
+    auto found = uniformLocations.find(name);
+    return found != uniformLocations.end() ? found->second : -1;
+}
+
+GLint ShaderProgram::getAttributeLocation(const std::string& name) const
+{
+    auto found = attributeLocations.find(name);
+    return found != attributeLocations.end() ? found->second : -1;
+}
+
+GLuint ShaderProgram::getUniformBlockIndex(const std::string& name) const
+{
+    for (const ShaderBlock& block : blocks)
+        if (block.name == name) return block.index;
+    return GL_INVALID_INDEX;
+}
+
+void ShaderProgram::printReflection() const
+{
+    std::cout << "Program " << id << ": " << uniforms.size() << " uniformi, " << attributes.size() << " atributa, "
+        << blocks.size() << " uniform blokova" << std::endl;
+    for (const ShaderVariable& uniform : uniforms)
+        std::cout << "  uniform " << uniform.name << " (lokacija " << uniform.location << ")" << std::endl;
+    for (const ShaderVariable& attribute : attributes)
+        std::cout << "  atribut " << attribute.name << " (lokacija " << attribute.location << ")" << std::endl;
+    for (const ShaderBlock& block : blocks)
+        std::cout << "  blok " << block.name << " (" << block.dataSize << " B, vezivanje " << block.binding << ")" << std::endl;
+}
+
+ShaderProgram createShaderProgram(const char* vsSource, const char* fsSource, const std::string& defines)
+{
+    return ShaderProgram(createShader(vsSource, fsSource, defines));
+}
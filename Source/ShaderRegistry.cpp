@@ -0,0 +1,146 @@
+#include "../Header/ShaderRegistry.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include "../Header/GLStateCache.h"
+#include "../Header/ShaderPreprocessor.h"
+#include "../Header/ShaderSources.h"
+#include "../Header/Util.h"
+
+// Opis: registar sejder programa sa pracenjem fajlova i zamjenom programa u toku rada
+
+ShaderRegistry::~ShaderRegistry()
+{
+    for (Entry& entry : entries) glState().deleteProgram(entry.program.getId());
+}
+
+int ShaderRegistry::add(const char* vsSource, const char* fsSource, const std::string& defines)
+{
+    //Isti program se ne pravi dvaput (npr. renderer u svakom prozoru sa dijeljenim kontekstom)
+    for (size_t i = 0; i < entries.size(); i++)
+        if (entries[i].vsSource == vsSource && entries[i].fsSource == fsSource && entries[i].defines == defines) return (int)i;
+
+    assert(!frozen && "ShaderRegistry::add posle freeze: svi programi moraju biti dodati prije pokretanja niti crtanja");
+    if (frozen)
+    {
+        std::cout << "Program " << vsSource << " + " << fsSource << " dodat posle pokretanja niti crtanja, ne pravi se" << std::endl;
+        return -1;
+    }
+
+    Entry entry;
+    entry.vsSource = vsSource;
+    entry.fsSource = fsSource;
+    entry.defines = defines;
+    entry.program.reflect(createShader(vsSource, fsSource, defines));
+    if (watcher != nullptr) watchFiles(entry);
+    entries.push_back(entry);
+    return (int)entries.size() - 1;
+}
+
+void ShaderRegistry::watchFiles(Entry& entry)
+{
+    //Spisak ukljucenih fajlova se pravi preprocesorom, jer se moze promijeniti sa svakom izmjenom sejdera
+    std::string code;
+    std::vector<std::string> included;
+    entry.files.clear();
+    preprocessShaderFile(entry.vsSource, entry.defines, code, &included);
+    entry.files.insert(entry.files.end(), included.begin(), included.end());
+    preprocessShaderFile(entry.fsSource, entry.defines, code, &included);
+    entry.files.insert(entry.files.end(), included.begin(), included.end());
+    for (const std::string& file : entry.files) watcher->watch(file);
+}
+
+unsigned ShaderRegistry::getProgram(int handle) const
+{
+    if (handle < 0 || handle >= (int)entries.size()) return 0;
+    return entries[handle].program.getId();
+}
+
+GLint ShaderRegistry::getUniformLocation(int handle, const char* name) const
+{
+    if (handle < 0 || handle >= (int)entries.size()) return -1;
+    return entries[handle].program.getUniformLocation(name);
+}
+
+const ShaderProgram& ShaderRegistry::getReflection(int handle) const
+{
+    static const ShaderProgram empty;
+    if (handle < 0 || handle >= (int)entries.size()) return empty;
+    return entries[handle].program;
+}
+
+void ShaderRegistry::setHotReload(bool enabled)
+{
+    if (enabled && frozen)
+    {
+        std::cout << "Pracenje sejdera ne radi dok niti crtanja citaju registar" << std::endl;
+        return;
+    }
+    hotReload = enabled;
+    //Ponovo ucitan sejder mora doci sa diska, a ne iz verzije ugradjene pri prevodjenju
+    if (enabled) setShaderDiskOverride(true);
+    if (!enabled || watcher != nullptr) return;
+    builder.reset(new ProgramBuilder());
+    watcher.reset(new FileWatcher());
+    for (Entry& entry : entries) watchFiles(entry);
+    std::cout << "Pracenje sejdera ukljuceno (" << (watcher->isNative() ? "inotify" : "provjera vremena izmjene") << ")" << std::endl;
+}
+
+void ShaderRegistry::rebuild(Entry& entry)
+{
+    if (entry.pendingBuild >= 0)
+    {
+        //Fajl je ponovo snimljen dok se prethodna verzija prevodi; prevodi se opet kad ona zavrsi
+        entry.changedWhileBuilding = true;
+        return;
+    }
+    watchFiles(entry);
+    entry.pendingBuild = builder->submit(entry.vsSource.c_str(), entry.fsSource.c_str(), entry.defines);
+}
+
+void ShaderRegistry::swapProgram(Entry& entry, unsigned program)
+{
+    glState().deleteProgram(entry.program.getId());
+    //Lokacije uniformi se razlikuju izmedju programa, pa se opis cita ponovo
+    entry.program.reflect(program);
+}
+
+void ShaderRegistry::update()
+{
+    if (!hotReload) return;
+
+    for (const std::string& path : watcher->poll())
+    {
+        for (Entry& entry : entries)
+            if (std::find(entry.files.begin(), entry.files.end(), path) != entry.files.end()) rebuild(entry);
+    }
+
+    if (builder->getPendingCount() == 0) return;
+    builder->poll();
+    for (Entry& entry : entries)
+    {
+        if (entry.pendingBuild < 0) continue;
+        ProgramBuildState state = builder->getState(entry.pendingBuild);
+        if (state == ProgramBuildState::Pending) continue;
+
+        if (state == ProgramBuildState::Ready)
+        {
+            swapProgram(entry, builder->getProgram(entry.pendingBuild));
+            reloads++;
+            std::cout << "Sejder ponovo ucitan: " << entry.vsSource << " + " << entry.fsSource << std::endl;
+        }
+        else
+        {
+            failedReloads++;
+            std::cout << "Sejder sa greskom, ostaje prethodna verzija: " << entry.vsSource << " + " << entry.fsSource << std::endl;
+        }
+        entry.pendingBuild = -1;
+        if (entry.changedWhileBuilding)
+        {
+            entry.changedWhileBuilding = false;
+            rebuild(entry);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#include "../Header/ShaderSources.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "../Header/EmbeddedShaders.h"
+#include "../Header/Hash.h"
+#include "../Header/Util.h"
+
+// Opis: izvorni kod sejdera iz programa (ugradjen pri prevodjenju) ili sa diska
+
+static bool diskOverride = false;
+
+const ShaderSource* findEmbeddedShader(const std::string& path)
+{
+    for (const ShaderSource& shader : EMBEDDED_SHADERS)
+        if (path == shader.path) return &shader;
+    return nullptr;
+}
+
+void setShaderDiskOverride(bool enabled)
+{
+    diskOverride = enabled;
+}
+
+bool isShaderDiskOverrideEnabled()
+{
+    return diskOverride;
+}
+
+bool loadShaderSource(const std::string& path, std::string& code)
+{
+    const ShaderSource* embedded = findEmbeddedShader(path);
+    if (embedded != nullptr && !diskOverride)
+    {
+        code.assign(embedded->code, embedded->size);
+        return true;
+    }
+
+    code = readShaderFile(path.c_str());
+    if (code.empty())
+    {
+        if (embedded == nullptr) return false;
+        code.assign(embedded->code, embedded->size); //Fajl je obrisan ili premjesten, ugradjena verzija i dalje radi
+        return true;
+    }
+    //Ugradjeni kod ima LF kraj reda (EmbedShaders.ps1), a checkout na Windowsu cesto CRLF; isti fajl ne smije izgledati izmijenjen
+    code.erase(std::remove(code.begin(), code.end(), '\r'), code.end());
+    if (embedded != nullptr && hashString(code) != embedded->hash)
+        std::cout << "Sejder \"" << path << "\" na disku se razlikuje od ugradjenog (ugradice se pri sledecem prevodjenju)" << std::endl;
+    return true;
+}
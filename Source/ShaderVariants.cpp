@@ -0,0 +1,23 @@
+#include "../Header/ShaderVariants.h"
+
+#include "../Header/ShaderPreprocessor.h"
+
+// Opis: kes varijanti sejder programa po maski osobina
+
+ShaderVariants::ShaderVariants(ShaderRegistry& shaders, const char* vsSource, const char* fsSource,
+    const std::vector<std::string>& featureNames)
+    : shaders(shaders), vsSource(vsSource), fsSource(fsSource), featureNames(featureNames)
+{
+}
+
+int ShaderVariants::getHandle(unsigned features)
+{
+    //Bitovi bez imena ne mijenjaju kod, pa ne smiju praviti novu varijantu
+    if (featureNames.size() < 32) features &= (1u << featureNames.size()) - 1;
+
+    auto found = variants.find(features);
+    if (found != variants.end()) return found->second;
+    int handle = shaders.add(vsSource.c_str(), fsSource.c_str(), featureDefines(features, featureNames));
+    variants[features] = handle;
+    return handle;
+}
@@ -0,0 +1,151 @@
+#include "../Header/SimulationThread.h"
+
+#include <chrono>
+
+// Opis: simulacija akvarijuma u posebnoj niti, snimci ka crtanju kroz trostruki bafer, ulaz kroz SPSC red
+
+double simulationClock()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+bool SimulationThread::start(int fishCount, unsigned seed, double tickRate, InputRecorder* recorder)
+{
+    if (running.load()) return false;
+    aquarium.init(fishCount, seed);
+    aquarium.setRecorder(recorder);
+    scheduler = FrameScheduler(tickRate);
+    tickSeconds = scheduler.getTickSeconds();
+
+    //Prvi snimak se objavljuje odmah, da crtanje nikad ne vidi prazan bafer
+    AquariumSnapshot& first = snapshots.getWriteBuffer();
+    first.previous = aquarium.getPreviousFish();
+    first.current = aquarium.getFish();
+    first.food = aquarium.getFood();
+    first.tick = 0;
+    first.alpha = 0;
+    first.time = simulationClock();
+    snapshots.publish();
+    snapshots.acquire();
+
+    running.store(true);
+    thread = std::thread(&SimulationThread::run, this);
+    return true;
+}
+
+void SimulationThread::stop()
+{
+    {
+        //Pod bravom, da nit koja upravo zaspi na zahtjevu ne propusti budjenje
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        if (!running.exchange(false)) return;
+    }
+    wakeCondition.notify_all();
+    if (thread.joinable()) thread.join();
+}
+
+void SimulationThread::setOnDemand(bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        onDemand.store(enabled);
+    }
+    wakeCondition.notify_all();
+}
+
+void SimulationThread::requestSnapshot()
+{
+    if (!onDemand.load()) return;
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    unsigned long long request = ++requested;
+    wakeCondition.notify_all();
+    wakeCondition.wait(lock, [&] { return served >= request || !running.load(); });
+}
+
+bool SimulationThread::pushInput(const AquariumInput& input)
+{
+    if (inputs.push(input)) return true;
+    droppedInputs++;
+    return false;
+}
+
+const AquariumSnapshot& SimulationThread::acquireSnapshot(bool* updated)
+{
+    bool fresh = snapshots.acquire();
+    if (updated != nullptr) *updated = fresh;
+    return snapshots.getReadBuffer();
+}
+
+float SimulationThread::getAlpha(const AquariumSnapshot& snapshot) const
+{
+    //Od objavljivanja je proteklo jos vremena; preko 1 se ne ide jer sledece stanje jos nije poznato
+    float alpha = snapshot.alpha + (float)((simulationClock() - snapshot.time) / tickSeconds);
+    return alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+}
+
+SimulationThreadStats SimulationThread::getStats() const
+{
+    SimulationThreadStats stats;
+    stats.ticks = ticks.load(std::memory_order_relaxed);
+    stats.snapshots = published.load(std::memory_order_relaxed);
+    stats.droppedInputs = droppedInputs;
+    return stats;
+}
+
+void SimulationThread::run()
+{
+    scheduler.advanceTo(simulationClock());
+    while (running.load(std::memory_order_acquire))
+    {
+        unsigned long long request = 0;
+        if (onDemand.load())
+        {
+            //Nista se ne crta dok crtanje ne zatrazi snimak, pa nema ni razloga da se otkucava
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait(lock, [&] { return requested != served || !running.load() || !onDemand.load(); });
+            if (requested != served) request = requested;
+        }
+        if (!running.load()) break;
+
+        double now = simulationClock();
+        int count = scheduler.advanceTo(now);
+        //Na zahtjev se snimak objavljuje i bez novog koraka, da crtanje dobije svjez alpha i vrijeme
+        if (count > 0 || request != 0)
+        {
+            AquariumInput input;
+            while (inputs.pop(input)) aquarium.apply(input);
+            for (int i = 0; i < count; i++) aquarium.step((float)scheduler.getTickSeconds());
+
+            AquariumSnapshot& snapshot = snapshots.getWriteBuffer();
+            snapshot.previous = aquarium.getPreviousFish();
+            snapshot.current = aquarium.getFish();
+            snapshot.food = aquarium.getFood();
+            snapshot.tick = aquarium.getTick();
+            snapshot.alpha = scheduler.getAlpha();
+            snapshot.time = now;
+            snapshots.publish();
+            ticks.fetch_add(count, std::memory_order_relaxed);
+            published.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (request != 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                served = request;
+            }
+            wakeCondition.notify_all();
+            continue;
+        }
+
+        //Spava do sledeceg koraka
+        double wait = (1.0 - scheduler.getAlpha()) * scheduler.getTickSeconds();
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+}
@@ -0,0 +1,127 @@
+#include "../Header/StreamBuffer.h"
+
+#include <iostream>
+
+#include "../Header/GLStateCache.h"
+
+// Opis: prstenasti bafer sa particijama cuvanim fence objektima, za podatke koji se salju svaki frejm
+
+StreamBuffer::~StreamBuffer()
+{
+    destroy();
+}
+
+bool StreamBuffer::create(GLenum bufferTarget, size_t bytesPerPartition, int partitionCount)
+{
+    destroy();
+    if (partitionCount < 1 || bytesPerPartition == 0) return false;
+
+    target = bufferTarget;
+    partitionSize = bytesPerPartition;
+    fences.assign(partitionCount, (GLsync)0);
+    partition = 0;
+    used = 0;
+    size_t totalSize = partitionSize * partitionCount;
+
+    glGenBuffers(1, &buffer);
+    glState().bindBuffer(target, buffer);
+    persistent = GLEW_ARB_buffer_storage;
+    if (persistent)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(target, (GLsizeiptr)totalSize, nullptr, flags);
+        persistentData = (unsigned char*)glMapBufferRange(target, 0, (GLsizeiptr)totalSize, flags);
+        if (persistentData == nullptr)
+        {
+            std::cout << "Trajno mapiranje bafera nije uspjelo!" << std::endl;
+            destroy();
+            return false;
+        }
+    }
+    else
+    {
+        glBufferData(target, (GLsizeiptr)totalSize, nullptr, GL_STREAM_DRAW);
+    }
+    return true;
+}
+
+void StreamBuffer::destroy()
+{
+    if (buffer == 0) return;
+    unmap();
+    for (GLsync& fence : fences)
+    {
+        if (fence != 0) glDeleteSync(fence);
+        fence = 0;
+    }
+    if (persistentData != nullptr)
+    {
+        glState().bindBuffer(target, buffer);
+        glUnmapBuffer(target);
+        persistentData = nullptr;
+    }
+    glState().deleteBuffer(buffer);
+    buffer = 0;
+}
+
+void StreamBuffer::beginFrame()
+{
+    if (buffer == 0) return;
+    partition = (partition + 1) % (int)fences.size();
+    used = 0;
+    stats.frames++;
+
+    GLsync& fence = fences[partition];
+    if (fence == 0) return;
+    //Fence je obicno vec prosao (GPU je zavrsio frejm od prije dva frejma), pa ovo ne ceka
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        stats.waits++;
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); //1 ms
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    fence = 0;
+}
+
+void* StreamBuffer::map(size_t size, size_t alignment, size_t& offset)
+{
+    if (buffer == 0 || mapped) return nullptr;
+    if (alignment == 0) alignment = 1;
+    size_t start = (used + alignment - 1) / alignment * alignment;
+    if (start + size > partitionSize)
+    {
+        stats.overflows++;
+        return nullptr;
+    }
+    used = start + size;
+    if (used > stats.peakBytes) stats.peakBytes = used;
+    offset = partition * partitionSize + start;
+
+    if (persistent) return persistentData + offset;
+
+    glState().bindBuffer(target, buffer);
+    void* data = glMapBufferRange(target, (GLintptr)offset, (GLsizeiptr)size,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    mapped = data != nullptr;
+    return data;
+}
+
+void StreamBuffer::unmap()
+{
+    if (!mapped) return;
+    glState().bindBuffer(target, buffer);
+    glUnmapBuffer(target);
+    mapped = false;
+}
+
+void StreamBuffer::endFrame()
+{
+    if (buffer == 0) return;
+    unmap();
+    GLsync& fence = fences[partition];
+    if (fence != 0) glDeleteSync(fence);
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,192 @@
+#include "../Header/TextureCache.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../Header/BlockCompression.h"
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+
+// Opis: kes dekodovanih tekstura na disku (zaglavlje + mip nivoi spremni za glTexImage2D/glCompressedTexImage2D)
+
+namespace fs = std::filesystem;
+
+static const char CACHE_MAGIC[4] = { 'K', 'T', 'C', '1' };
+static const unsigned int CACHE_VERSION = 1;
+
+struct CachedTextureHeader {
+    char magic[4];
+    unsigned int version;
+    unsigned long long key; // Hes sadrzaja izvornog fajla i opcija
+    unsigned int format;
+    unsigned int compressed;
+    unsigned int levelCount;
+    unsigned int reserved;
+};
+
+struct CachedTextureLevel {
+    unsigned int width;
+    unsigned int height;
+    unsigned long long offset; // Od pocetka fajla
+    unsigned long long size;
+};
+
+static std::string cacheDirectory;
+static TextureCacheStats stats;
+
+void setTextureCacheDirectory(const std::string& directory)
+{
+    cacheDirectory = directory;
+    if (cacheDirectory.empty()) return;
+
+    std::error_code error;
+    fs::create_directories(cacheDirectory, error);
+    if (error)
+    {
+        std::cout << "Kes tekstura nije ukljucen, ne moze se napraviti folder \"" << cacheDirectory << "\"!" << std::endl;
+        cacheDirectory.clear();
+    }
+}
+
+bool isTextureCacheEnabled()
+{
+    return !cacheDirectory.empty();
+}
+
+const TextureCacheStats& getTextureCacheStats()
+{
+    return stats;
+}
+
+static unsigned optionBits(const TextureLoadOptions& options)
+{
+    unsigned bits = (options.flipVertically ? 1u : 0u) | (options.generateMipmaps ? 2u : 0u);
+    if (options.compression != TextureCompression::None)
+    {
+        //Izabrani format zavisi i od toga sta drajver podrzava, pa i to ulazi u kljuc
+        bits |= (unsigned)options.compression << 2;
+        bits |= isTextureCompressionSupported(TextureCompression::BC3) ? 1u << 6 : 0u;
+        bits |= isTextureCompressionSupported(TextureCompression::BC7) ? 1u << 7 : 0u;
+    }
+    return bits;
+}
+
+static unsigned uploadFromEntry(const MappedFile& entry, unsigned long long key)
+{
+    if (entry.size() < sizeof(CachedTextureHeader)) return 0;
+    CachedTextureHeader header;
+    memcpy(&header, entry.data(), sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, 4) != 0 || header.version != CACHE_VERSION || header.key != key) return 0;
+    if (header.levelCount == 0 || header.levelCount > 32) return 0;
+    if (entry.size() < sizeof(header) + header.levelCount * sizeof(CachedTextureLevel)) return 0;
+
+    std::vector<TextureLevel> levels(header.levelCount);
+    for (unsigned i = 0; i < header.levelCount; i++)
+    {
+        CachedTextureLevel stored;
+        memcpy(&stored, entry.data() + sizeof(header) + i * sizeof(stored), sizeof(stored));
+        if (stored.offset + stored.size > entry.size()) return 0; //Fajl je odsjecen
+        levels[i].width = (int)stored.width;
+        levels[i].height = (int)stored.height;
+        levels[i].offset = (size_t)stored.offset;
+        levels[i].size = (size_t)stored.size;
+    }
+    return uploadTexture(header.format, header.compressed != 0, levels.data(), levels.size(), entry.data());
+}
+
+static void writeEntry(const std::string& entryPath, unsigned long long key, const TextureImage& image)
+{
+    CachedTextureHeader header;
+    memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.format = image.format;
+    header.compressed = image.compressed ? 1 : 0;
+    header.levelCount = (unsigned)image.levels.size();
+    header.reserved = 0;
+
+    //Pikseli pocinju poravnati na 16 bajtova iza tabele nivoa
+    size_t dataOffset = sizeof(header) + image.levels.size() * sizeof(CachedTextureLevel);
+    dataOffset = (dataOffset + 15) & ~(size_t)15;
+
+    //Pisemo u privremeni fajl pa ga preimenujemo, da drugi proces nikad ne vidi pola upisan unos
+    std::string tempPath = entryPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return;
+        file.write((const char*)&header, sizeof(header));
+        for (const TextureLevel& level : image.levels)
+        {
+            CachedTextureLevel stored = { (unsigned)level.width, (unsigned)level.height, dataOffset + level.offset, level.size };
+            file.write((const char*)&stored, sizeof(stored));
+        }
+        const char padding[16] = {};
+        file.write(padding, dataOffset - (sizeof(header) + image.levels.size() * sizeof(CachedTextureLevel)));
+        file.write((const char*)image.pixels.data(), image.pixels.size());
+        if (!file.good()) return;
+    }
+    std::error_code error;
+    fs::rename(tempPath, entryPath, error);
+    if (error) fs::remove(tempPath, error);
+}
+
+static void removeStaleEntries(const std::string& prefix, const std::string& currentName)
+{
+    //Stari unosi istog izvornog fajla (prije izmjene slike) vise nikad nece biti pogodjeni
+    std::error_code error;
+    for (const fs::directory_entry& file : fs::directory_iterator(cacheDirectory, error))
+    {
+        std::string name = file.path().filename().string();
+        if (name != currentName && name.compare(0, prefix.size(), prefix) == 0)
+            fs::remove(file.path(), error);
+    }
+}
+
+unsigned loadTextureThroughCache(const char* filePath, const TextureLoadOptions& options)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    MappedFile source;
+    if (!source.open(filePath)) return 0;
+
+    unsigned long long key = hashBytes(source.data(), source.size(), (unsigned long long)optionBits(options) << 32 | CACHE_VERSION);
+    std::string prefix = hashToHex(hashString(filePath, optionBits(options))) + "-";
+    std::string entryName = prefix + hashToHex(key) + ".tex";
+    std::string entryPath = (fs::path(cacheDirectory) / entryName).string();
+
+    MappedFile entry;
+    if (entry.open(entryPath.c_str()))
+    {
+        unsigned texture = uploadFromEntry(entry, key);
+        if (texture != 0)
+        {
+            stats.hits++;
+            stats.hitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return texture;
+        }
+        entry.close(); //Ostecen unos, pravimo ga ponovo
+    }
+
+    TextureImage image;
+    if (!decodeImage(source.data(), source.size(), options, image)) return 0;
+    writeEntry(entryPath, key, image);
+    removeStaleEntries(prefix, entryName);
+    unsigned texture = uploadTexture(image);
+
+    stats.misses++;
+    stats.missSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return texture;
+}
+
+void printTextureCacheReport()
+{
+    if (stats.hits + stats.misses == 0) return;
+    std::cout << "Kes tekstura: " << stats.hits << " iz kesa (" << stats.hitSeconds * 1000.0 << " ms, toplo), "
+        << stats.misses << " dekodovano (" << stats.missSeconds * 1000.0 << " ms, hladno)" << std::endl;
+    if (stats.hits > 0 && stats.misses > 0)
+        std::cout << "Prosjek po teksturi: " << stats.hitSeconds * 1000.0 / stats.hits << " ms iz kesa, "
+            << stats.missSeconds * 1000.0 / stats.misses << " ms dekodovanje" << std::endl;
+}
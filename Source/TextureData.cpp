@@ -0,0 +1,158 @@
+#include "../Header/TextureData.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../Header/BlockCompression.h"
+#include "../Header/GLStateCache.h"
+#include "../Header/JobSystem.h"
+#include "../Header/MappedFile.h"
+#include "../Header/stb_image.h"
+
+// Opis: dekodovanje slika, pravljenje mip nivoa i slanje gotovih nivoa na graficku karticu
+
+GLenum textureFormatForChannels(int channels)
+{
+    switch (channels) {
+    case 1: return GL_RED;
+    case 2: return GL_RG;
+    case 3: return GL_RGB;
+    case 4: return GL_RGBA;
+    default: return GL_RGB;
+    }
+}
+
+int textureChannelsForFormat(GLenum format)
+{
+    switch (format) {
+    case GL_RED: return 1;
+    case GL_RG: return 2;
+    case GL_RGB: return 3;
+    case GL_RGBA: return 4;
+    default: return 0;
+    }
+}
+
+void layoutTextureLevels(int width, int height, int channels, bool mipmaps, std::vector<TextureLevel>& levels)
+{
+    levels.clear();
+    size_t offset = 0;
+    while (true)
+    {
+        TextureLevel level;
+        level.width = width;
+        level.height = height;
+        level.offset = offset;
+        level.size = (size_t)width * height * channels;
+        levels.push_back(level);
+        offset += level.size;
+
+        if (!mipmaps || (width == 1 && height == 1)) break;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+}
+
+static void downsample(const unsigned char* src, const TextureLevel& srcLevel, unsigned char* dst, const TextureLevel& dstLevel, int channels,
+    int firstRow, int lastRow)
+{
+    //Svaki piksel manjeg nivoa je prosjek 2x2 piksela veceg (na neparnim ivicama se zadnji red/kolona ponavlja)
+    for (int y = firstRow; y < lastRow; y++)
+    {
+        int y0 = y * 2;
+        int y1 = y0 + 1 < srcLevel.height ? y0 + 1 : y0;
+        for (int x = 0; x < dstLevel.width; x++)
+        {
+            int x0 = x * 2;
+            int x1 = x0 + 1 < srcLevel.width ? x0 + 1 : x0;
+            for (int c = 0; c < channels; c++)
+            {
+                int sum = src[((size_t)y0 * srcLevel.width + x0) * channels + c]
+                    + src[((size_t)y0 * srcLevel.width + x1) * channels + c]
+                    + src[((size_t)y1 * srcLevel.width + x0) * channels + c]
+                    + src[((size_t)y1 * srcLevel.width + x1) * channels + c];
+                dst[((size_t)y * dstLevel.width + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+bool decodeImage(const unsigned char* fileData, size_t fileSize, const TextureLoadOptions& options, TextureImage& image)
+{
+    int width, height, channels;
+    unsigned char* decoded = stbi_load_from_memory(fileData, (int)fileSize, &width, &height, &channels, 0);
+    if (decoded == NULL) return false;
+
+    image.format = textureFormatForChannels(channels);
+    image.compressed = false;
+    layoutTextureLevels(width, height, channels, false, image.levels);
+    const TextureLevel& last = image.levels.back();
+    image.pixels.resize(last.offset + last.size);
+
+    size_t rowSize = (size_t)width * channels;
+    for (int y = 0; y < height; y++)
+    {
+        int srcRow = options.flipVertically ? height - 1 - y : y;
+        memcpy(&image.pixels[y * rowSize], decoded + srcRow * rowSize, rowSize);
+    }
+    stbi_image_free(decoded);
+
+    if (options.generateMipmaps) generateTextureMipmaps(image);
+    if (options.compression != TextureCompression::None)
+        compressTextureImage(image, options.compression);
+    return true;
+}
+
+void generateTextureMipmaps(TextureImage& image)
+{
+    int channels = textureChannelsForFormat(image.format);
+    if (image.compressed || channels == 0 || image.levels.empty()) return;
+
+    layoutTextureLevels(image.levels[0].width, image.levels[0].height, channels, true, image.levels);
+    const TextureLevel& last = image.levels.back();
+    image.pixels.resize(last.offset + last.size);
+    for (size_t i = 1; i < image.levels.size(); i++)
+    {
+        //Redovi jednog nivoa su nezavisni; nivoi idu redom jer svaki cita prethodni
+        const TextureLevel& src = image.levels[i - 1];
+        const TextureLevel& dst = image.levels[i];
+        unsigned char* pixels = image.pixels.data();
+        int grain = std::max(1, 16384 / dst.width);
+        jobSystem().parallelFor(0, dst.height, grain, [&](int firstRow, int lastRow) {
+            downsample(pixels + src.offset, src, pixels + dst.offset, dst, channels, firstRow, lastRow);
+        });
+    }
+}
+
+bool decodeImageFile(const char* filePath, const TextureLoadOptions& options, TextureImage& image)
+{
+    MappedFile file;
+    if (!file.open(filePath)) return false;
+    return decodeImage(file.data(), file.size(), options, image);
+}
+
+unsigned uploadTexture(GLenum format, bool compressed, const TextureLevel* levels, size_t levelCount, const unsigned char* data)
+{
+    if (levelCount == 0) return 0;
+
+    GLint previousAlignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); //Redovi RGB slika neparne sirine nisu poravnati na 4 bajta
+
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glState().bindTextureUnit(0, GL_TEXTURE_2D, texture);
+    for (size_t i = 0; i < levelCount; i++)
+    {
+        const TextureLevel& level = levels[i];
+        if (compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, format, level.width, level.height, 0, (GLsizei)level.size, data + level.offset);
+        else
+            glTexImage2D(GL_TEXTURE_2D, (GLint)i, format, level.width, level.height, 0, format, GL_UNSIGNED_BYTE, data + level.offset);
+    }
+    //Tekstura je kompletna i sa podrazumijevanim mipmap filterom, cak i kad ima samo jedan nivo
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levelCount - 1);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+    return texture;
+}
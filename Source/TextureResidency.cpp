@@ -0,0 +1,169 @@
+#include "../Header/TextureResidency.h"
+
+#include "../Header/GLStateCache.h"
+#include "../Header/Util.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Opis: menadzer rezidentnosti tekstura sa LRU izbacivanjem kad se predje budzet video memorije
+
+size_t textureByteSize(unsigned texture)
+{
+    glState().bindTextureUnit(0, GL_TEXTURE_2D, texture);
+
+    size_t total = 0;
+    for (int level = 0; level < 16; level++)
+    {
+        GLint width = 0, height = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &height);
+        if (width == 0 || height == 0) break; //Nema vise nivoa
+
+        GLint compressed = GL_FALSE;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED, &compressed);
+        if (compressed == GL_TRUE)
+        {
+            GLint size = 0;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+            total += (size_t)size;
+            continue;
+        }
+
+        //Drajver prijavljuje broj bitova po kanalu stvarnog formata (npr. GL_RGB se cesto cuva kao RGBA8)
+        GLint bits = 0, channelBits = 0;
+        const GLenum channels[] = { GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE };
+        for (GLenum channel : channels)
+        {
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, channel, &channelBits);
+            bits += channelBits;
+        }
+        total += (size_t)width * height * ((bits + 7) / 8);
+    }
+    return total;
+}
+
+size_t parseTextureBudget(int argc, char** argv)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::string(argv[i]) != "--texture-budget") continue;
+        double megabytes = std::atof(argv[i + 1]);
+        if (megabytes >= 0) return (size_t)(megabytes * 1024.0 * 1024.0);
+    }
+    return (size_t)256 * 1024 * 1024;
+}
+
+TextureResidency::TextureResidency(size_t budgetBytes)
+{
+    stats.budgetBytes = budgetBytes;
+}
+
+TextureResidency::~TextureResidency()
+{
+    evictAll();
+}
+
+unsigned TextureResidency::add(const char* filePath, const TextureParams& params)
+{
+    Entry entry;
+    entry.path = filePath;
+    entry.params = params;
+    entries.push_back(entry);
+    return (unsigned)entries.size() - 1;
+}
+
+unsigned TextureResidency::use(unsigned handle)
+{
+    if (handle >= entries.size()) return 0;
+    Entry& entry = entries[handle];
+    entry.lastUsedFrame = frame;
+
+    if (entry.texture != 0)
+    {
+        //Vec je rezidentna, samo je pomjeri na pocetak LRU liste
+        lru.splice(lru.begin(), lru, entry.lruIt);
+        return entry.texture;
+    }
+
+    unsigned texture = loadImageToTexture(entry.path.c_str());
+    if (texture == 0) return 0;
+
+    glState().bindTextureUnit(0, GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, entry.params.minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, entry.params.magFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, entry.params.wrapS);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, entry.params.wrapT);
+
+    if (entry.everLoaded) stats.refaults++;
+    entry.everLoaded = true;
+    entry.texture = texture;
+    entry.bytes = textureByteSize(texture);
+    lru.push_front(handle);
+    entry.lruIt = lru.begin();
+    stats.residentBytes += entry.bytes;
+    stats.residentCount++;
+
+    enforceBudget();
+    return texture;
+}
+
+void TextureResidency::beginFrame()
+{
+    frame++;
+    enforceBudget();
+}
+
+void TextureResidency::setBudget(size_t budgetBytes)
+{
+    stats.budgetBytes = budgetBytes;
+    enforceBudget();
+}
+
+void TextureResidency::setPinned(unsigned handle, bool pinned)
+{
+    if (handle >= entries.size()) return;
+    entries[handle].pinned = pinned;
+    if (!pinned) enforceBudget();
+}
+
+void TextureResidency::evictAll()
+{
+    for (Entry& entry : entries)
+    {
+        if (entry.texture != 0) evict(entry);
+    }
+}
+
+void TextureResidency::evict(Entry& entry)
+{
+    glState().deleteTexture(entry.texture);
+    entry.texture = 0;
+    lru.erase(entry.lruIt);
+    stats.residentBytes -= entry.bytes;
+    stats.residentCount--;
+    entry.bytes = 0;
+}
+
+void TextureResidency::enforceBudget()
+{
+    //Idemo od kraja LRU liste i preskacemo zakucane; staje se na prvoj teksturi koristenoj u ovom frejmu jer su sve ispred nje novije
+    std::list<unsigned>::iterator it = lru.end();
+    while (stats.residentBytes > stats.budgetBytes && it != lru.begin())
+    {
+        --it;
+        Entry& oldest = entries[*it];
+        if (oldest.lastUsedFrame == frame) break;
+        if (oldest.pinned) continue;
+        ++it; //evict brise element na koji je it pokazivao
+        evict(oldest);
+        stats.evictions++;
+    }
+}
+
+void TextureResidency::printReport() const
+{
+    std::cout << "Teksture: " << stats.residentCount << " rezidentnih, " << stats.residentBytes / 1024.0 << " KB od budzeta "
+        << stats.budgetBytes / 1024.0 << " KB, " << stats.evictions << " izbacivanja, " << stats.refaults << " ponovnih ucitavanja" << std::endl;
+}
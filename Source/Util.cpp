@@ -1,12 +1,18 @@
 #include "../Header/Util.h";
 
 #define _CRT_SECURE_NO_WARNINGS
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../Header/stb_image.h"
+#include "../Header/Ktx2.h"
+#include "../Header/ProgramCache.h"
+#include "../Header/ShaderPreprocessor.h"
+#include "../Header/ShaderSources.h"
+#include "../Header/TextureCache.h"
 
 // Autor: Nedeljko Tesanovic
 // Opis: pomocne funkcije za zaustavljanje programa, ucitavanje sejdera, tekstura i kursora
@@ -18,11 +24,9 @@ int endProgram(std::string message) {
     return -1;
 }
 
-unsigned int compileShader(GLenum type, const char* source)
+std::string readShaderFile(const char* source)
 {
-    //Uzima kod u fajlu na putanji "source", kompajlira ga i vraca sejder tipa "type"
-    //Citanje izvornog koda iz fajla
-    std::string content = "";
+    //Citanje izvornog koda iz fajla na putanji "source"
     std::ifstream file(source);
     std::stringstream ss;
     if (file.is_open())
@@ -35,9 +39,12 @@ unsigned int compileShader(GLenum type, const char* source)
         ss << "";
         std::cout << "Greska pri citanju fajla sa putanje \"" << source << "\"!" << std::endl;
     }
-    std::string temp = ss.str();
-    const char* sourceCode = temp.c_str(); //Izvorni kod sejdera koji citamo iz fajla na putanji "source"
+    return ss.str();
+}
 
+unsigned int compileShader(GLenum type, const char* sourceCode)
+{
+    //Kompajlira izvorni kod "sourceCode" i vraca sejder tipa "type"
     int shader = glCreateShader(type); //Napravimo prazan sejder odredjenog tipa (vertex ili fragment)
 
     int success; //Da li je kompajliranje bilo uspjesno (1 - da)
@@ -58,18 +65,20 @@ unsigned int compileShader(GLenum type, const char* source)
     }
     return shader;
 }
-unsigned int createShader(const char* vsSource, const char* fsSource)
+static unsigned int linkShaderProgram(const std::string& vsCode, const std::string& fsCode)
 {
-    //Pravi objedinjeni sejder program koji se sastoji od Vertex sejdera ciji je kod na putanji vsSource
-
     unsigned int program; //Objedinjeni sejder
     unsigned int vertexShader; //Verteks sejder (za prostorne podatke)
     unsigned int fragmentShader; //Fragment sejder (za boje, teksture itd)
 
     program = glCreateProgram(); //Napravi prazan objedinjeni sejder program
 
-    vertexShader = compileShader(GL_VERTEX_SHADER, vsSource); //Napravi i kompajliraj vertex sejder
-    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsSource); //Napravi i kompajliraj fragment sejder
+    vertexShader = compileShader(GL_VERTEX_SHADER, vsCode.c_str()); //Napravi i kompajliraj vertex sejder
+    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsCode.c_str()); //Napravi i kompajliraj fragment sejder
+
+    //Binarni program se moze procitati za kes samo ako se to najavi prije linkovanja
+    if (isProgramCacheEnabled())
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
     //Zakaci verteks i fragment sejdere za objedinjeni program
     glAttachShader(program, vertexShader);
@@ -97,41 +106,76 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
     return program;
 }
 
+static unsigned int createShaderFromCode(const std::string& cacheName, const std::string& vsCode, const std::string& fsCode, const std::string& defines)
+{
+    //Ako je kes sejdera ukljucen, linkovan program se cita sa diska umjesto da se ponovo prevodi
+    unsigned long long cacheKey = 0;
+    if (isProgramCacheEnabled())
+    {
+        cacheKey = programCacheKey(vsCode, fsCode, defines);
+        unsigned int cached = loadCachedProgram(cacheName, cacheKey);
+        if (cached != 0) return cached;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    unsigned int program = linkShaderProgram(vsCode, fsCode);
+    if (isProgramCacheEnabled())
+        storeCachedProgram(cacheName, cacheKey, program, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return program;
+}
+
+unsigned int createShader(const char* vsSource, const char* fsSource)
+{
+    return createShader(vsSource, fsSource, "");
+}
+
+unsigned int createShader(const char* vsSource, const char* fsSource, const std::string& defines)
+{
+    //Pravi objedinjeni sejder program koji se sastoji od Vertex sejdera ciji je kod na putanji vsSource
+    //Kod prolazi kroz preprocesor (#include, definicije iz "defines" iza #version linije); fajlovi iz foldera Shaders
+    //su ugradjeni u program, pa se sa diska citaju samo uz setShaderDiskOverride
+    std::string vsCode, fsCode;
+    preprocessShaderFile(vsSource, defines, vsCode);
+    preprocessShaderFile(fsSource, defines, fsCode);
+    return createShaderFromCode(std::string(vsSource) + "|" + fsSource + "|" + defines, vsCode, fsCode, defines);
+}
+
+unsigned int createShader(const ShaderSource& vsSource, const ShaderSource& fsSource, const std::string& defines)
+{
+    //Isto, za kod koji je vec u memoriji
+    std::string vsCode, fsCode;
+    preprocessShaderCode(vsSource.path, std::string(vsSource.code, vsSource.size), defines, vsCode);
+    preprocessShaderCode(fsSource.path, std::string(fsSource.code, fsSource.size), defines, fsCode);
+    return createShaderFromCode(std::string(vsSource.path) + "|" + fsSource.path + "|" + defines, vsCode, fsCode, defines);
+}
+
 unsigned loadImageToTexture(const char* filePath) {
-    int TextureWidth;
-    int TextureHeight;
-    int TextureChannels;
-    unsigned char* ImageData = stbi_load(filePath, &TextureWidth, &TextureHeight, &TextureChannels, 0);
-    if (ImageData != NULL)
+    return loadImageToTexture(filePath, TextureLoadOptions());
+}
+
+unsigned loadImageToTexture(const char* filePath, const TextureLoadOptions& options) {
+    //KTX2 fajlovi su vec pripremljeni (mip nivoi, kompresija), pa se nivoi salju direktno bez dekodovanja
+    std::string Path = filePath;
+    if (Path.size() > 5 && Path.compare(Path.size() - 5, 5, ".ktx2") == 0)
+        return loadKtx2Texture(filePath);
+
+    //Ako je kes tekstura ukljucen, slika se dekoduje samo pri prvom pokretanju, posle se cita gotova iz kesa
+    unsigned Texture = 0;
+    if (isTextureCacheEnabled())
     {
-        //Slike se osnovno ucitavaju naopako pa se moraju ispraviti da budu uspravne
-        stbi__vertical_flip(ImageData, TextureWidth, TextureHeight, TextureChannels);
-
-        // Provjerava koji je format boja ucitane slike
-        GLint InternalFormat = -1;
-        switch (TextureChannels) {
-        case 1: InternalFormat = GL_RED; break;
-        case 2: InternalFormat = GL_RG; break;
-        case 3: InternalFormat = GL_RGB; break;
-        case 4: InternalFormat = GL_RGBA; break;
-        default: InternalFormat = GL_RGB; break;
-        }
-
-        unsigned int Texture;
-        glGenTextures(1, &Texture);
-        glBindTexture(GL_TEXTURE_2D, Texture);
-        glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, TextureWidth, TextureHeight, 0, InternalFormat, GL_UNSIGNED_BYTE, ImageData);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        // oslobadjanje memorije zauzete sa stbi_load posto vise nije potrebna
-        stbi_image_free(ImageData);
-        return Texture;
+        Texture = loadTextureThroughCache(filePath, options);
     }
     else
     {
-        std::cout << "Textura nije ucitana! Putanja texture: " << filePath << std::endl;
-        stbi_image_free(ImageData);
-        return 0;
+        // Dekoduje sliku, ispravlja je da bude uspravna i po potrebi pravi mip nivoe
+        TextureImage Image;
+        if (decodeImageFile(filePath, options, Image))
+            Texture = uploadTexture(Image);
     }
+
+    if (Texture == 0)
+        std::cout << "Textura nije ucitana! Putanja texture: " << filePath << std::endl;
+    return Texture;
 }
 
 GLFWcursor* loadImageToCursor(const char* filePath) {
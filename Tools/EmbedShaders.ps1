@@ -0,0 +1,61 @@
+# Ugradjuje sve sejdere (.vert, .frag, .glsl) iz foldera Shaders u Header/EmbeddedShaders.h kao constexpr stringove.
+# Poziva se kao pre-build korak projekta; izlazni fajl se prepisuje samo kad se sadrzaj promijeni,
+# da se ne bi bez potrebe ponovo prevodio kod koji ga ukljucuje.
+param(
+    [Parameter(Mandatory = $true)][string]$ShaderDir,
+    [Parameter(Mandatory = $true)][string]$Output,
+    [string]$PathPrefix = "Shaders"
+)
+
+$ErrorActionPreference = "Stop"
+$ShaderDir = (Resolve-Path $ShaderDir).Path.TrimEnd('\', '/')
+$files = Get-ChildItem -Path $ShaderDir -Recurse -File | Where-Object { $_.Extension -in ".vert", ".frag", ".glsl" } | Sort-Object FullName
+
+# MSVC ne dozvoljava string literal duzi od ~16 KB, pa se kod dijeli na vise spojenih literala
+$maxPiece = 4000
+$nl = "`n"
+
+$out = New-Object System.Text.StringBuilder
+[void]$out.Append("#pragma once$nl")
+[void]$out.Append("// Generisano iz foldera Shaders (Tools/EmbedShaders.ps1, pre-build korak). Ne mijenjati rucno.$nl")
+[void]$out.Append("#include `"Hash.h`"$nl")
+[void]$out.Append("#include `"ShaderSources.h`"$nl")
+
+$entries = @()
+foreach ($file in $files) {
+    $relative = $file.FullName.Substring($ShaderDir.Length + 1).Replace('\', '/')
+    $path = "$PathPrefix/$relative"
+    $name = "EMBEDDED_" + ($relative -replace '[^A-Za-z0-9]', '_').ToUpper()
+    $text = [System.IO.File]::ReadAllText($file.FullName).Replace("`r`n", "`n")
+    if ($text.Contains(')glsl"')) { throw "$path sadrzi )glsl`" i ne moze se ugraditi kao raw string" }
+
+    [void]$out.Append("$nl// $path$nl")
+    [void]$out.Append("static constexpr char $name[] =$nl")
+    $pieces = @()
+    $piece = ""
+    foreach ($line in ($text -split "(?<=`n)")) {
+        if ($piece.Length + $line.Length -gt $maxPiece -and $piece.Length -gt 0) {
+            $pieces += $piece
+            $piece = ""
+        }
+        $piece += $line
+    }
+    $pieces += $piece
+    foreach ($p in $pieces) { [void]$out.Append("    R`"glsl($p)glsl`"$nl") }
+    [void]$out.Append("    ;$nl")
+    $entries += "    { `"$path`", $name, sizeof($name) - 1, hashLiteral($name, sizeof($name) - 1) },"
+}
+
+[void]$out.Append("$nl")
+if ($entries.Count -eq 0) {
+    [void]$out.Append("static constexpr ShaderSource EMBEDDED_SHADERS[] = { { `"`", `"`", 0, 0 } };$nl")
+} else {
+    [void]$out.Append("static constexpr ShaderSource EMBEDDED_SHADERS[] = {$nl")
+    foreach ($entry in $entries) { [void]$out.Append("$entry$nl") }
+    [void]$out.Append("};$nl")
+}
+
+$content = $out.ToString()
+if ((Test-Path $Output) -and ([System.IO.File]::ReadAllText($Output) -eq $content)) { exit 0 }
+[System.IO.File]::WriteAllText($Output, $content, (New-Object System.Text.UTF8Encoding $false))
+Write-Host "Ugradjeno sejdera: $($files.Count) -> $Output"